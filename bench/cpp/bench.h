@@ -0,0 +1,19 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include <benchmark/benchmark.h>
+
+// config.lua and lib/ from the working directory, once; false when they are missing
+bool loadLua();
+
+// joins the dispatcher thread if a benchmark started it
+void stopDispatcher();
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <set>
+
+#include <fmt/format.h>
+
+#include <core/modulemanager.h>
+#include <core/tasks.h>
+
+#include "bench.h"
+
+namespace
+{
+    std::once_flag dispatcherStarted;
+    bool dispatcherRunning = false;
+
+    // modules x handlers on one event, connected the way module.connect does
+    void prepareEvent(const std::string& event, const std::string& identifier, int64_t modules, int64_t handlers)
+    {
+        static std::set<std::string> prepared;
+        if (!prepared.insert(event).second) {
+            return;
+        }
+
+        lua_State* L = g_lua->getLuaState();
+        for (int64_t i = 0; i < modules; ++i) {
+            // owned by g_modules like a loaded module, never freed
+            Module* module = new Module(g_modules.get(), fmt::format("{:s}_{:d}", event, i), "");
+            for (int64_t j = 0; j < handlers; ++j) {
+                luaL_loadstring(L, "return function(args) return args.id end");
+                lua_pcall(L, 0, 1, 0);
+                module->connect(event, luaL_ref(L, LUA_REGISTRYINDEX), identifier.empty() ? identifier : fmt::format("{:s}{:d}", identifier, j));
+            }
+        }
+    }
+}
+
+bool loadLua()
+{
+    static bool loaded = g_lua->init();
+    return loaded;
+}
+
+void stopDispatcher()
+{
+    if (dispatcherRunning) {
+        g_dispatcher.shutdown();
+        g_dispatcher.join();
+    }
+}
+
+namespace
+{
+    void BM_ModuleManagerEmitNoRet(benchmark::State& state)
+    {
+        if (!loadLua()) {
+            state.SkipWithError("config.lua or lib/ not found in the working directory");
+            return;
+        }
+
+        const std::string event = fmt::format("onBench{:d}x{:d}", state.range(0), state.range(1));
+        prepareEvent(event, "", state.range(0), state.range(1));
+
+        for (auto _ : state) {
+            g_modules->emitNoRet(event, "", std::tuple{"id", 1});
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    }
+    BENCHMARK(BM_ModuleManagerEmitNoRet)->Args({1, 1})->Args({10, 1})->Args({1, 10})->Args({10, 10});
+
+    // onReceiveNetworkMessage: one handler per opcode
+    void BM_ModuleManagerEmitNoRetIdentified(benchmark::State& state)
+    {
+        if (!loadLua()) {
+            state.SkipWithError("config.lua or lib/ not found in the working directory");
+            return;
+        }
+
+        const std::string event = fmt::format("onBenchIdentified{:d}x{:d}", state.range(0), state.range(1));
+        prepareEvent(event, "opcode", state.range(0), state.range(1));
+
+        const std::string identifier = "opcode0";
+        for (auto _ : state) {
+            g_modules->emitNoRet(event, identifier, std::tuple{"id", 1});
+        }
+    }
+    BENCHMARK(BM_ModuleManagerEmitNoRetIdentified)->Args({1, 1})->Args({10, 10});
+
+    // producer side; the dispatcher thread runs the empty tasks meanwhile
+    void BM_DispatcherAddTask(benchmark::State& state)
+    {
+        std::call_once(dispatcherStarted, []() {
+            g_dispatcher.start();
+            dispatcherRunning = true;
+        });
+
+        for (auto _ : state) {
+            g_dispatcher.addTask(createTask([]() {}));
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        // drained before the next run measures
+        if (state.thread_index() == 0) {
+            while (g_dispatcher.getQueueSize() != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    BENCHMARK(BM_DispatcherAddTask)->Threads(1)->Threads(4)->UseRealTime();
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <utils/rsa.h>
+#include <utils/tools.h>
+#include <utils/xtea.h>
+
+#include "bench.h"
+
+namespace
+{
+    uint32_t KEY[] = {0x1234567, 0x89ABCDE, 0xF012345, 0x6789ABC};
+
+    std::vector<uint8_t> makePayload(size_t size)
+    {
+        std::vector<uint8_t> payload(size);
+        std::mt19937 random{42};
+        for (uint8_t& byte : payload) {
+            byte = static_cast<uint8_t>(random());
+        }
+        return payload;
+    }
+
+    void BM_XteaEncrypt(benchmark::State& state)
+    {
+        const std::vector<uint8_t> payload = makePayload(state.range(0));
+        for (auto _ : state) {
+            OutputMessage msg;
+            msg.addBytes(reinterpret_cast<const char*>(payload.data()), payload.size());
+            g_XTEA.encrypt(KEY, msg);
+            benchmark::DoNotOptimize(msg.getOutputBuffer());
+        }
+        state.SetBytesProcessed(state.iterations() * payload.size());
+    }
+    BENCHMARK(BM_XteaEncrypt)->Arg(64)->Arg(1024)->Arg(8192);
+
+    // decrypts the same blocks again every iteration, the rounds do not care
+    void BM_XteaDecrypt(benchmark::State& state)
+    {
+        const std::vector<uint8_t> payload = makePayload(state.range(0));
+        NetworkMessage msg;
+        memcpy(msg.getBuffer() + NetworkMessage::HEADER_LENGTH + NetworkMessage::CHECKSUM_LENGTH, payload.data(), payload.size());
+
+        for (auto _ : state) {
+            // as Connection leaves it: size header read, checksum skipped
+            msg.getBodyBuffer();
+            msg.skipBytes(NetworkMessage::CHECKSUM_LENGTH);
+            msg.setLength(static_cast<NetworkMessage::MsgSize_t>(payload.size() + 6));
+            benchmark::DoNotOptimize(g_XTEA.decrypt(KEY, msg));
+        }
+        state.SetBytesProcessed(state.iterations() * payload.size());
+    }
+    BENCHMARK(BM_XteaDecrypt)->Arg(64)->Arg(1024)->Arg(8192);
+
+    void BM_AdlerChecksum(benchmark::State& state)
+    {
+        const std::vector<uint8_t> payload = makePayload(state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(adlerChecksum(payload.data(), payload.size()));
+        }
+        state.SetBytesProcessed(state.iterations() * payload.size());
+    }
+    BENCHMARK(BM_AdlerChecksum)->Arg(64)->Arg(1024)->Arg(8192);
+
+    // encryptionSalt + password of a login
+    void BM_TransformToSHA1(benchmark::State& state)
+    {
+        const std::string input(state.range(0), 'x');
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(transformToSHA1(input));
+        }
+        state.SetBytesProcessed(state.iterations() * input.size());
+    }
+    BENCHMARK(BM_TransformToSHA1)->Arg(32)->Arg(64)->Arg(256);
+
+    // the result is garbage, the private key operation costs the same
+    void BM_RsaDecrypt(benchmark::State& state)
+    {
+        static bool loaded = [] {
+            try {
+                g_RSA.loadPEM();
+                return true;
+            } catch (const std::exception&) {
+                return false;
+            }
+        }();
+        if (!loaded) {
+            state.SkipWithError("key.pem not found in the working directory");
+            return;
+        }
+
+        std::vector<uint8_t> block = makePayload(128);
+        // below the modulus
+        block[0] = 0;
+
+        NetworkMessage msg;
+        for (auto _ : state) {
+            msg.reset();
+            memcpy(msg.getBuffer() + NetworkMessage::INITIAL_BUFFER_POSITION, block.data(), block.size());
+            msg.setLength(NetworkMessage::INITIAL_BUFFER_POSITION + 128);
+            benchmark::DoNotOptimize(g_RSA.decrypt(msg));
+        }
+    }
+    BENCHMARK(BM_RsaDecrypt)->Unit(benchmark::kMicrosecond);
+}
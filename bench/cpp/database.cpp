@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <deque>
+
+#include <database/accountstore.h>
+#include <database/dbresult.h>
+
+#include "bench.h"
+
+namespace
+{
+    /**
+     * Stored result built by hand in the public libmariadb layout, which
+     * mysql_fetch_field/mysql_fetch_row/mysql_fetch_lengths walk without a
+     * connection (handle is nullptr); shaped like the players query of
+     * MySQLAccountStore. As in a stored result the values of a row are
+     * consecutive and '\0' terminated, with one more pointer past the last
+     * one to measure it.
+     */
+    class FakeResult
+    {
+        public:
+            explicit FakeResult(size_t rows) {
+                static const char* names[] = {"name", "account_id", "level", "instance_id", "instance_name", "auto_reconnect"};
+                for (const char* name : names) {
+                    MYSQL_FIELD field{};
+                    field.name = const_cast<char*>(name);
+                    m_fields.push_back(field);
+                }
+
+                for (size_t row = 0; row < rows; ++row) {
+                    const std::string values[] = {"Player" + std::to_string(row), "1234", std::to_string(row % 100 + 1),
+                        "5f0c6a3e-9a44-4c7e-8f55-1f0f44b4f9d2", "pokemon-world-01", std::to_string(row % 2)};
+
+                    std::string& data = m_values.emplace_back();
+                    std::vector<size_t> offsets;
+                    for (const std::string& value : values) {
+                        offsets.push_back(data.size());
+                        data.append(value).push_back('\0');
+                    }
+                    offsets.push_back(data.size());
+
+                    std::vector<char*>& pointers = m_rowPointers.emplace_back();
+                    for (size_t offset : offsets) {
+                        pointers.push_back(data.data() + offset);
+                    }
+                }
+                m_lengths.resize(m_fields.size());
+
+                m_rows.resize(rows);
+                for (size_t row = 0; row < rows; ++row) {
+                    m_rows[row].data = m_rowPointers[row].data();
+                    m_rows[row].next = row + 1 < rows ? &m_rows[row + 1] : nullptr;
+                }
+
+                m_data.data = rows != 0 ? m_rows.data() : nullptr;
+                m_data.rows = rows;
+                m_data.fields = static_cast<unsigned int>(m_fields.size());
+            }
+
+            // rewound for the next DBResult
+            MYSQL_RES* get() {
+                m_result = MYSQL_RES{};
+                m_result.row_count = m_data.rows;
+                m_result.fields = m_fields.data();
+                m_result.field_count = static_cast<unsigned int>(m_fields.size());
+                m_result.data = &m_data;
+                m_result.data_cursor = m_data.data;
+                m_result.lengths = m_lengths.data();
+                return &m_result;
+            }
+
+        private:
+            std::vector<MYSQL_FIELD> m_fields;
+            // m_rowPointers point into these, m_values must not reallocate
+            std::deque<std::string> m_values;
+            std::vector<std::vector<char*>> m_rowPointers;
+            std::vector<unsigned long> m_lengths;
+            std::vector<MYSQL_ROWS> m_rows;
+            MYSQL_DATA m_data{};
+            MYSQL_RES m_result{};
+    };
+
+    void BM_DBResultParse(benchmark::State& state)
+    {
+        FakeResult fake(state.range(0));
+        for (auto _ : state) {
+            DBResult result(fake.get());
+            benchmark::DoNotOptimize(result.hasNext());
+            result.release();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DBResultParse)->Arg(1)->Arg(10)->Arg(100);
+
+    // lookup by name for every cell
+    void BM_DBResultRead(benchmark::State& state)
+    {
+        FakeResult fake(state.range(0));
+        for (auto _ : state) {
+            DBResult result(fake.get());
+            while (result.hasNext()) {
+                benchmark::DoNotOptimize(result.getString("name"));
+                benchmark::DoNotOptimize(result.getString("instance_name"));
+                benchmark::DoNotOptimize(result.getString("instance_id"));
+                benchmark::DoNotOptimize(result.getNumber<uint16_t>("level"));
+                benchmark::DoNotOptimize(result.getNumber<int>("auto_reconnect"));
+                result.next();
+            }
+            result.release();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DBResultRead)->Arg(1)->Arg(10)->Arg(100);
+
+    // what MySQLAccountStore::getCharacterList does with every row
+    void BM_DBResultBinding(benchmark::State& state)
+    {
+        static const DBBinding<Character> binding = DBBinding<Character>()
+            .bind("name", &Character::name)
+            .bind("instance_name", &Character::instanceName)
+            .bind("instance_id", &Character::instanceId)
+            .bind("level", &Character::level)
+            .bind("auto_reconnect", &Character::autoReconnect);
+
+        FakeResult fake(state.range(0));
+        for (auto _ : state) {
+            DBResult result(fake.get());
+            benchmark::DoNotOptimize(binding.readAll(result));
+            result.release();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DBResultBinding)->Arg(1)->Arg(10)->Arg(100);
+}
@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <core/logger.h>
+
+#include "bench.h"
+
+// ./loginserver_bench [--benchmark_filter=<regex>] [--benchmark_format=json] [--benchmark_out=<file>]
+// from the directory with config.lua, lib/ and key.pem
+int main(int argc, char* argv[]) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // keeps the console for the benchmark report
+    g_logger.setLevel(SeveretyLevel::Warning);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    stopDispatcher();
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <network/connectionmanager.h>
+#include <network/outputmessage.h>
+
+#include "bench.h"
+
+namespace
+{
+    // fields of the GameServerHost request / answer in modules/login
+    const std::string INSTANCE_NAME = "pokemon-world-01";
+    const std::string INSTANCE_ID = "5f0c6a3e-9a44-4c7e-8f55-1f0f44b4f9d2";
+
+    void BM_NetworkMessageAdd(benchmark::State& state)
+    {
+        OutputMessage msg;
+        for (auto _ : state) {
+            msg.reset();
+            for (int i = 0; i < 64; ++i) {
+                msg.addByte(static_cast<uint8_t>(i));
+                msg.add<uint16_t>(static_cast<uint16_t>(i));
+                msg.add<uint32_t>(static_cast<uint32_t>(i));
+            }
+            benchmark::DoNotOptimize(msg.getBuffer());
+        }
+        state.SetBytesProcessed(state.iterations() * 64 * 7);
+    }
+    BENCHMARK(BM_NetworkMessageAdd);
+
+    void BM_NetworkMessageGet(benchmark::State& state)
+    {
+        OutputMessage msg;
+        for (int i = 0; i < 64; ++i) {
+            msg.addByte(static_cast<uint8_t>(i));
+            msg.add<uint16_t>(static_cast<uint16_t>(i));
+            msg.add<uint32_t>(static_cast<uint32_t>(i));
+        }
+        const NetworkMessage::MsgSize_t length = msg.getLength();
+
+        for (auto _ : state) {
+            msg.reset();
+            msg.setLength(length);
+            uint32_t sum = 0;
+            for (int i = 0; i < 64; ++i) {
+                sum += msg.getByte();
+                sum += msg.get<uint16_t>();
+                sum += msg.get<uint32_t>();
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetBytesProcessed(state.iterations() * length);
+    }
+    BENCHMARK(BM_NetworkMessageGet);
+
+    void BM_NetworkMessageAddString(benchmark::State& state)
+    {
+        OutputMessage msg;
+        for (auto _ : state) {
+            msg.reset();
+            msg.addString(INSTANCE_NAME);
+            msg.addString(INSTANCE_ID);
+            benchmark::DoNotOptimize(msg.getBuffer());
+        }
+        state.SetBytesProcessed(state.iterations() * (INSTANCE_NAME.size() + INSTANCE_ID.size() + 4));
+    }
+    BENCHMARK(BM_NetworkMessageAddString);
+
+    void BM_NetworkMessageGetString(benchmark::State& state)
+    {
+        OutputMessage msg;
+        msg.addString(INSTANCE_NAME);
+        msg.addString(INSTANCE_ID);
+        const NetworkMessage::MsgSize_t length = msg.getLength();
+
+        for (auto _ : state) {
+            msg.reset();
+            msg.setLength(length);
+            std::string instanceName = msg.getString();
+            std::string instanceId = msg.getString();
+            benchmark::DoNotOptimize(instanceName.data());
+            benchmark::DoNotOptimize(instanceId.data());
+        }
+        state.SetBytesProcessed(state.iterations() * length);
+    }
+    BENCHMARK(BM_NetworkMessageGetString);
+
+    void BM_NetworkMessageGetStringView(benchmark::State& state)
+    {
+        OutputMessage msg;
+        msg.addString(INSTANCE_NAME);
+        msg.addString(INSTANCE_ID);
+        const NetworkMessage::MsgSize_t length = msg.getLength();
+
+        for (auto _ : state) {
+            msg.reset();
+            msg.setLength(length);
+            std::string_view instanceName = msg.getStringView();
+            std::string_view instanceId = msg.getStringView();
+            benchmark::DoNotOptimize(instanceName.data());
+            benchmark::DoNotOptimize(instanceId.data());
+        }
+        state.SetBytesProcessed(state.iterations() * length);
+    }
+    BENCHMARK(BM_NetworkMessageGetStringView);
+
+    // linear in the connection count, runs for every Lua lookup of a client
+    void BM_ConnectionManagerGetProtocolById(benchmark::State& state)
+    {
+        boost::asio::io_context ioContext;
+        std::vector<uint64_t> ids;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            ids.push_back(g_connectionManager.createConnection(ioContext)->getId());
+        }
+
+        std::mt19937 random{42};
+        std::uniform_int_distribution<size_t> distribution(0, ids.size() - 1);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(g_connectionManager.getProtocolById(ids[distribution(random)]));
+        }
+
+        g_connectionManager.closeAll();
+    }
+    BENCHMARK(BM_ConnectionManagerGetProtocolById)->Arg(100)->Arg(1000)->Arg(10000);
+}
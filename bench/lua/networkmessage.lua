@@ -0,0 +1,101 @@
+-- NetworkMessage C API vs FFI fast path.
+--
+-- Replays the packet work of modules/login/login_main.lua: decoding the
+-- GameServerHost request (_onReceiveNetworkMessage) and encoding the answer
+-- (g_login.sendGameServerHost).
+--
+-- Usage: ./loginserver --script bench/lua/networkmessage.lua [iterations]
+
+local iterations = tonumber(SCRIPT_ARGS and SCRIPT_ARGS[1]) or 1000000
+
+if not g_messageFFI or not g_messageFFI.enabled then
+  print("FFI fast path is not enabled (luaFFI = false or LuaJIT without FFI), nothing to compare.")
+  return
+end
+
+local capi = g_messageFFI.capi
+local fast = g_messageFFI.ffi
+local seek, reset = g_messageFFI.seek, g_messageFFI.reset
+local initialPosition = NetworkMessage.layout.initialPosition
+
+local request = OutputMessage()
+request:addString("pokemon-world-01")
+request:addString("5f0c6a3e-9a44-4c7e-8f55-1f0f44b4f9d2")
+
+local answer = OutputMessage()
+
+local function decode(api)
+  seek(request, initialPosition)
+  local instanceName = api.getString(request)
+  local instanceId = api.getString(request)
+  return instanceName, instanceId
+end
+
+local function encode(api)
+  reset(answer)
+  api.addU8(answer, ProtocolCode.GameServerHost)
+  api.addString(answer, "game01.pokeworld.local")
+  api.addU16(answer, 7172)
+end
+
+-- one boundary crossing per packet (NetworkMessage:read/write)
+local bulk = {}
+
+function bulk.decode()
+  seek(request, initialPosition)
+  return request:read("s s")
+end
+
+function bulk.encode()
+  reset(answer)
+  answer:write("u8 s u16", ProtocolCode.GameServerHost, "game01.pokeworld.local", 7172)
+end
+
+-- encoders generated from the packet schemas (network/packets.h)
+local schema = {}
+
+function schema.decode()
+  seek(request, initialPosition)
+  return Packet.GameServerHostRequest.decode(request)
+end
+
+function schema.encode()
+  reset(answer)
+  Packet.GameServerHost.encode(answer, "game01.pokeworld.local", 7172)
+end
+
+local function measure(name, api, func)
+  -- warm up so the JIT has a chance to compile the loop
+  for _ = 1, 10000 do
+    func(api)
+  end
+
+  collectgarbage()
+  local start = os.clock()
+  for _ = 1, iterations do
+    func(api)
+  end
+  local elapsed = os.clock() - start
+
+  local ns = elapsed * 1e9 / iterations
+  print(string.format("%-24s %10.1f ns/op", name, ns))
+  return ns
+end
+
+print(string.format("NetworkMessage benchmark, %d iterations (%s)", iterations, jit and jit.version or _VERSION))
+
+assert(select(2, decode(capi)) == select(2, decode(fast)), "decoders disagree")
+
+local decodeC = measure("decode (C API)", capi, decode)
+local decodeFFI = measure("decode (FFI)", fast, decode)
+measure("decode (read)", nil, bulk.decode)
+measure("decode (schema)", nil, schema.decode)
+local encodeC = measure("encode (C API)", capi, encode)
+local encodeFFI = measure("encode (FFI)", fast, encode)
+measure("encode (write)", nil, bulk.encode)
+measure("encode (schema)", nil, schema.encode)
+
+print(string.format("speedup: decode %.2fx, encode %.2fx", decodeC / decodeFFI, encodeC / encodeFFI))
+
+request:delete()
+answer:delete()
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef CORE_FAULTINJECTOR_H
+#define CORE_FAULTINJECTOR_H
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+enum class FaultTarget : uint8_t {
+    Database, // Database::storeQuery and the memory AccountStore
+    RedisPublish, // RedisPublisher::publish
+    RedisDelivery, // messages read by RedisSubscriber
+
+    Count
+};
+
+/**
+ * Slows down or fails the calls to MySQL and redis for load tests, set per
+ * target from config.lua (faultDatabase, faultRedisPublish,
+ * faultRedisDelivery) or on /faults of the HTTP port:
+ *
+ *   latency=<ms>,distribution=fixed|uniform|exponential,errors=<0..1>,stalls=<0..1>,stall=<ms>
+ *
+ * uniform draws from [0, 2 x latency], exponential has a mean of latency.
+ * The delay is slept on the calling thread, where the real dependency would
+ * block it too. Targets without a profile cost one relaxed load.
+ */
+class FaultInjector
+{
+    public:
+        enum class Distribution : uint8_t {
+            Fixed,
+            Uniform,
+            Exponential,
+        };
+
+        struct Profile {
+            uint32_t latency = 0; // ms
+            Distribution distribution = Distribution::Fixed;
+            double errorRate = 0;
+            double stallRate = 0;
+            uint32_t stall = 0; // ms
+
+            bool isActive() const {
+                return latency != 0 || errorRate > 0 || (stallRate > 0 && stall != 0);
+            }
+        };
+
+        FaultInjector() = default;
+
+        // non-copyable
+        FaultInjector(const FaultInjector&) = delete;
+        FaultInjector& operator=(const FaultInjector&) = delete;
+
+        // false on an unknown key or value, the profile is left as it was
+        static bool parseProfile(const std::string& spec, Profile& profile, std::string& error);
+        static bool parseTarget(const std::string& name, FaultTarget& target);
+        static const char* getTargetName(FaultTarget target);
+
+        void setProfile(FaultTarget target, const Profile& profile);
+        Profile getProfile(FaultTarget target);
+
+        // sleeps as the profile says, false when the call has to fail
+        bool inject(FaultTarget target) {
+            if (!m_active[static_cast<size_t>(target)].load(std::memory_order_relaxed)) {
+                return true;
+            }
+            return applyProfile(target);
+        }
+
+        uint64_t getErrors() const;
+        uint64_t getStalls() const;
+
+        // profile and counters of every target
+        std::string dump();
+
+    private:
+        static constexpr size_t TARGETS = static_cast<size_t>(FaultTarget::Count);
+
+        bool applyProfile(FaultTarget target);
+
+        std::array<std::atomic<bool>, TARGETS> m_active{};
+        std::array<std::atomic<uint64_t>, TARGETS> m_calls{};
+        std::array<std::atomic<uint64_t>, TARGETS> m_errors{};
+        std::array<std::atomic<uint64_t>, TARGETS> m_stalls{};
+
+        std::mutex m_mutex;
+        std::array<Profile, TARGETS> m_profiles;
+};
+
+extern FaultInjector g_faultInjector;
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef CORE_FLIGHTRECORDER_H
+#define CORE_FLIGHTRECORDER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+enum class LoginStage : uint8_t {
+    Decode,
+    RsaDecrypt,
+    Database,
+    BuildResponse,
+    Send,
+
+    Count
+};
+
+// copied word by word through the recorder slots, so no member initializers: value-initialize it
+struct SlowLogin {
+    int64_t timestamp; // unix ms
+    uint32_t ip;
+    uint32_t accountId;
+    uint32_t dbRows; // character rows returned by the AccountStore, 0 when the list came from the cache
+    uint32_t dispatcherLag; // us, last task waiting in the dispatcher queue
+    uint32_t total; // us
+    std::array<uint32_t, static_cast<size_t>(LoginStage::Count)> stages; // us
+    uint8_t result; // FlightRecorder::Result
+};
+
+static_assert(std::is_trivially_copyable_v<SlowLogin>, "SlowLogin is copied with memcpy");
+
+/**
+ * Keeps the last N logins slower than slowLoginThreshold, dumped by SIGUSR1
+ * or /slowlogins on the HTTP port.
+ *
+ * Writers claim a slot with one fetch_add and publish it through a per-slot
+ * sequence number (odd while written), readers retry or skip slots that
+ * change under them; nothing ever blocks. Logins under the threshold only
+ * pay for the clock reads of LoginTimer.
+ */
+class FlightRecorder
+{
+    public:
+        enum Result : uint8_t {
+            Ok,
+            Failed,
+            Rejected,
+        };
+
+        FlightRecorder() = default;
+
+        // non-copyable
+        FlightRecorder(const FlightRecorder&) = delete;
+        FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+        // threshold in ms, 0 disables; capacity: logins kept
+        void setup(uint32_t threshold, size_t capacity);
+
+        bool isEnabled() const {
+            return m_threshold != 0;
+        }
+
+        uint32_t getThreshold() const {
+            return m_threshold;
+        }
+
+        void record(const SlowLogin& login);
+
+        // text table, slowest first
+        std::string dump() const;
+        bool dumpToFile(const std::string& directory) const;
+
+    private:
+        static constexpr size_t WORDS = (sizeof(SlowLogin) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};
+            std::array<std::atomic<uint64_t>, WORDS> words{};
+        };
+
+        bool read(const Slot& slot, SlowLogin& login) const;
+
+        uint32_t m_threshold = 0;
+        size_t m_capacity = 0;
+        std::unique_ptr<Slot[]> m_slots;
+        std::atomic<uint64_t> m_next{0};
+};
+
+extern FlightRecorder g_flightRecorder;
+
+// stage timings of one login, handed to the recorder if it was slow
+class LoginTimer
+{
+    public:
+        LoginTimer() : m_start(std::chrono::steady_clock::now()), m_stageStart(m_start) {}
+
+        // ends the running stage (added to stage), the next one starts now
+        void stage(LoginStage stage);
+
+        void setIp(uint32_t ip) {
+            m_login.ip = ip;
+        }
+        void setAccount(uint32_t accountId, uint32_t dbRows) {
+            m_login.accountId = accountId;
+            m_login.dbRows = dbRows;
+        }
+
+        void finish(FlightRecorder::Result result);
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+        std::chrono::steady_clock::time_point m_stageStart;
+        SlowLogin m_login{};
+};
+
+#endif
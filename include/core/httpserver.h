@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef CORE_HTTPSERVER_H
+#define CORE_HTTPSERVER_H
+
+#include <includes.h>
+
+#include <core/threadholder.h>
+
+struct HttpRequest {
+    std::string method;
+    std::string path;
+    std::unordered_map<std::string, std::string> query;
+};
+
+struct HttpResponse {
+    int status = 200;
+    std::string contentType = "text/plain; charset=utf-8";
+    std::string body;
+};
+
+using HttpHandler = std::function<HttpResponse(const HttpRequest&)>;
+
+/**
+ * Minimal HTTP/1.1 server for local tooling (metrics scraping, admin
+ * commands), one request per connection. Runs its own io_context on its
+ * own thread so a slow client never holds up the login traffic; handlers
+ * run on that thread and have to queue Lua work on the dispatcher.
+ */
+class HttpServer : public ThreadHolder<HttpServer>
+{
+    public:
+        HttpServer() = default;
+
+        // non-copyable
+        HttpServer(const HttpServer&) = delete;
+        HttpServer& operator=(const HttpServer&) = delete;
+
+        // routes have to be added before the thread is started
+        void addRoute(const std::string& path, HttpHandler handler);
+
+        bool open(const std::string& host, int32_t port);
+        void shutdown();
+
+        void threadMain();
+
+    private:
+        struct Session;
+
+        void accept();
+        void onRequest(const std::shared_ptr<Session>& session);
+        void sendResponse(const std::shared_ptr<Session>& session, const HttpResponse& response);
+
+        static HttpRequest parseRequest(const std::string& requestLine);
+
+        boost::asio::io_context m_ioContext;
+        std::unique_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
+
+        std::unordered_map<std::string, HttpHandler> m_routes;
+};
+
+extern HttpServer g_httpServer;
+
+#endif
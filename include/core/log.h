@@ -8,6 +8,9 @@
 #ifndef CORE_LOG_H
 #define CORE_LOG_H
 
+#include <chrono>
+#include <string>
+
 enum class SeveretyLevel {
     Trace,
     Debug,
@@ -20,20 +23,26 @@ enum class SeveretyLevel {
 class Log
 {
     public:
-        Log(SeveretyLevel severetyLevel, const std::string& message) :
-            m_severetyLevel(severetyLevel), m_message(message) {}
+        Log() = default;
+        Log(SeveretyLevel severetyLevel, std::string message) :
+            m_severetyLevel(severetyLevel), m_time(std::chrono::system_clock::now()), m_message(std::move(message)) {}
         ~Log() = default;
 
-        SeveretyLevel getSeveretyLevel() {
+        SeveretyLevel getSeveretyLevel() const {
             return m_severetyLevel;
         }
 
-        const std::string& getMessage() {
+        std::chrono::system_clock::time_point getTime() const {
+            return m_time;
+        }
+
+        const std::string& getMessage() const {
             return m_message;
         }
 
     private:
-        SeveretyLevel m_severetyLevel;
+        SeveretyLevel m_severetyLevel = SeveretyLevel::Info;
+        std::chrono::system_clock::time_point m_time;
         std::string m_message;
 };
 
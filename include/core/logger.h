@@ -8,12 +8,51 @@
 #ifndef CORE_LOGGER_H
 #define CORE_LOGGER_H
 
-#include <list>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include <core/log.h>
+#include <core/threadholder.h>
+
+#ifndef LOGGER_MIN_LEVEL
+// SeveretyLevel as a number, 0 keeps trace
+#define LOGGER_MIN_LEVEL 0
+#endif
 
-class Logger
+/**
+ * Asynchronous logger. Every thread appends to its own single-producer
+ * ring, a writer thread drains the rings in batches to stdout and to a
+ * size-rotated file (logFile, logMaxFileSize, logMaxFiles).
+ *
+ * A full ring drops messages under error (counted and reported by the
+ * writer) or, with logOverflow = "block", waits for the writer; errors and
+ * fatals always wait. Messages under the minimum level (logLevel, /loglevel
+ * on the HTTP port) are discarded before they are queued. Until start() and after shutdown() logs are written
+ * synchronously, fatal() always waits until it was written.
+ *
+ * With arguments the message is a fmt format string, checked against the
+ * arguments at compile time and formatted only once the level and the
+ * repeat limit let it through. Each call site (each distinct message for
+ * the string overloads) gets a token bucket per thread, logRepeatBurst
+ * messages and then logRepeatRate per second; what is held back is
+ * reported as "N similar messages suppressed" on the next message that
+ * passes. Levels under LOGGER_MIN_LEVEL are compiled out.
+ */
+class Logger : public ThreadHolder<Logger>
 {
     public:
+        enum class Overflow {
+            Drop,
+            Block,
+        };
+
         Logger();
         ~Logger();
 
@@ -21,9 +60,44 @@ class Logger
         Logger(const Logger&) = delete;
         Logger& operator=(const Logger&) = delete;
 
-        void writeLog(Log* log);
+        // has to be called before the thread is started, empty path disables the file
+        void setFile(const std::string& path, size_t maxSize, uint32_t maxFiles);
+        void setOverflow(Overflow overflow) {
+            m_overflow = overflow;
+        }
+
+        // per call site and thread: burst messages, then rate per second; rate 0 disables
+        void setRepeatLimit(double rate, double burst) {
+            m_repeatRate = rate;
+            m_repeatBurst = std::max(burst, 1.0);
+        }
+
+        void setLevel(SeveretyLevel level) {
+            m_minLevel.store(level, std::memory_order_relaxed);
+        }
+        SeveretyLevel getLevel() const {
+            return m_minLevel.load(std::memory_order_relaxed);
+        }
+        bool isEnabled(SeveretyLevel level) const {
+            return level >= getLevel();
+        }
+
+        static bool parseLevel(const std::string& name, SeveretyLevel& level);
+        static const char* getLevelName(SeveretyLevel level);
+
+        uint64_t getDropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+        uint64_t getWritten() const {
+            return m_written.load(std::memory_order_relaxed);
+        }
+
+        void addLog(SeveretyLevel level, std::string message);
+        // blocks until everything queued so far is written
+        void flush();
 
-        void addLog(Log* log);
+        void shutdown();
+        void threadMain();
 
         void log(const std::string& message);
         void trace(const std::string& message);
@@ -33,10 +107,96 @@ class Logger
         void error(const std::string& message);
         void fatal(const std::string& message);
 
+        template <typename Arg, typename... Args>
+        void trace(fmt::format_string<const Arg&, const Args&...> format, const Arg& arg, const Args&... args) {
+            logFormat<SeveretyLevel::Trace>(format, arg, args...);
+        }
+        template <typename Arg, typename... Args>
+        void debug(fmt::format_string<const Arg&, const Args&...> format, const Arg& arg, const Args&... args) {
+            logFormat<SeveretyLevel::Debug>(format, arg, args...);
+        }
+        template <typename Arg, typename... Args>
+        void info(fmt::format_string<const Arg&, const Args&...> format, const Arg& arg, const Args&... args) {
+            logFormat<SeveretyLevel::Info>(format, arg, args...);
+        }
+        template <typename Arg, typename... Args>
+        void warning(fmt::format_string<const Arg&, const Args&...> format, const Arg& arg, const Args&... args) {
+            logFormat<SeveretyLevel::Warning>(format, arg, args...);
+        }
+        template <typename Arg, typename... Args>
+        void error(fmt::format_string<const Arg&, const Args&...> format, const Arg& arg, const Args&... args) {
+            logFormat<SeveretyLevel::Error>(format, arg, args...);
+        }
+        template <typename Arg, typename... Args>
+        void fatal(fmt::format_string<const Arg&, const Args&...> format, const Arg& arg, const Args&... args) {
+            logFormat<SeveretyLevel::Fatal>(format, arg, args...);
+            flush();
+        }
+
         void printBacktrace(int level = 32);
 
     private:
-        std::list<Log*> m_logList;
+        static constexpr size_t RING_SIZE = 1024;
+        static constexpr size_t MAX_REPEAT_BUCKETS = 4096;
+
+        struct Ring {
+            std::array<Log, RING_SIZE> entries;
+            // head is written by the owning thread, tail by the writer
+            std::atomic<size_t> head{0};
+            std::atomic<size_t> tail{0};
+        };
+
+        template <SeveretyLevel level, typename... Args>
+        void logFormat(fmt::format_string<const Args&...> format, const Args&... args) {
+            if constexpr (static_cast<int>(level) >= LOGGER_MIN_LEVEL) {
+                uint64_t suppressed = 0;
+                if (isEnabled(level) && acquireToken(reinterpret_cast<uintptr_t>(fmt::string_view(format).data()), level, suppressed)) {
+                    pushLog(level, fmt::format(format, args...), suppressed);
+                }
+            }
+        }
+
+        bool acquireToken(uintptr_t key, SeveretyLevel level, uint64_t& suppressed);
+        void pushLog(SeveretyLevel level, std::string message, uint64_t suppressed);
+
+        Ring& getRing();
+        bool drain(std::vector<Log>& batch);
+        // drains and writes on the calling thread, once the writer stopped
+        void writeQueued();
+
+        void writeLogs(std::vector<Log>& batch);
+        void writeLog(const Log& log);
+        void openFile();
+        void rotateFile();
+
+        std::atomic<SeveretyLevel> m_minLevel{SeveretyLevel::Trace};
+        Overflow m_overflow = Overflow::Drop;
+        double m_repeatRate = 0;
+        double m_repeatBurst = 1;
+
+        std::atomic<bool> m_running{false};
+        std::atomic<bool> m_stopping{false};
+        std::atomic<uint64_t> m_dropped{0};
+        std::atomic<uint64_t> m_written{0};
+        uint64_t m_reportedDropped = 0;
+
+        std::mutex m_ringsLock;
+        std::vector<std::unique_ptr<Ring>> m_rings;
+        static thread_local Ring* s_ring;
+
+        std::mutex m_signalLock;
+        std::condition_variable m_signal;
+        std::condition_variable m_flushed;
+        uint64_t m_flushRequests = 0;
+        uint64_t m_flushesDone = 0;
+
+        // stdout and the file, held by whoever is writing
+        std::mutex m_writeLock;
+        std::string m_filePath;
+        std::ofstream m_file;
+        size_t m_fileSize = 0;
+        size_t m_maxFileSize = 0;
+        uint32_t m_maxFiles = 0;
 };
 
 extern Logger g_logger;
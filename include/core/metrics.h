@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef CORE_METRICS_H
+#define CORE_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Runtime metrics, rendered in the Prometheus text format (/metrics on the
+ * HTTP port, see core/httpserver.h).
+ *
+ * Counters and histograms are split in per-thread shards, updating them is
+ * a relaxed atomic add on a cache line no other thread writes to; the
+ * shards are only summed up when rendered.
+ */
+static constexpr size_t METRIC_SHARDS = 16;
+
+// shard of the calling thread, assigned round robin on first use
+inline size_t metricShard()
+{
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+class MetricCounter
+{
+    public:
+        void inc(uint64_t value = 1) {
+            m_shards[metricShard()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const;
+
+    private:
+        struct alignas(64) Shard {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Shard, METRIC_SHARDS> m_shards;
+};
+
+class MetricGauge
+{
+    public:
+        void set(int64_t value) {
+            m_value.store(value, std::memory_order_relaxed);
+        }
+        void add(int64_t value) {
+            m_value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        int64_t value() const {
+            return m_value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * Log-linear (HDR style) histogram of microseconds: every power of two is
+ * split in 4 sub-buckets, so a value is placed within 25% of its size, from
+ * 1 us up to 2^24 us (~16.8 s); larger values only count in +Inf.
+ */
+class MetricHistogram
+{
+    public:
+        static constexpr size_t SUB_BUCKETS = 4;
+        static constexpr size_t MAX_EXPONENT = 24;
+        static constexpr size_t BUCKETS = SUB_BUCKETS + (MAX_EXPONENT - 2) * SUB_BUCKETS;
+
+        struct Snapshot {
+            // the last one counts values over every bucket
+            std::array<uint64_t, BUCKETS + 1> counts{};
+            uint64_t count = 0;
+            uint64_t sumMicros = 0;
+        };
+
+        void observe(uint64_t micros) {
+            Shard& shard = m_shards[metricShard()];
+            shard.counts[getBucket(micros)].fetch_add(1, std::memory_order_relaxed);
+            shard.sumMicros.fetch_add(micros, std::memory_order_relaxed);
+        }
+
+        void observe(std::chrono::steady_clock::duration elapsed) {
+            observe(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        }
+
+        Snapshot snapshot() const;
+
+        static size_t getBucket(uint64_t micros);
+        // exclusive upper bound of the bucket in microseconds
+        static uint64_t getUpperBound(size_t bucket);
+
+    private:
+        struct alignas(64) Shard {
+            std::array<std::atomic<uint64_t>, BUCKETS + 1> counts{};
+            std::atomic<uint64_t> sumMicros{0};
+        };
+        std::array<Shard, METRIC_SHARDS> m_shards;
+};
+
+// observes the lifetime of the scope
+class MetricTimer
+{
+    public:
+        explicit MetricTimer(MetricHistogram& histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+        ~MetricTimer() {
+            m_histogram.observe(std::chrono::steady_clock::now() - m_start);
+        }
+
+        // non-copyable
+        MetricTimer(const MetricTimer&) = delete;
+        MetricTimer& operator=(const MetricTimer&) = delete;
+
+    private:
+        MetricHistogram& m_histogram;
+        std::chrono::steady_clock::time_point m_start;
+};
+
+class Metrics
+{
+    public:
+        Metrics();
+
+        // non-copyable
+        Metrics(const Metrics&) = delete;
+        Metrics& operator=(const Metrics&) = delete;
+
+        // values owned by other components, read when rendered
+        void addCallbackGauge(const std::string& name, const std::string& help, std::function<double()> callback);
+        void addCallbackCounter(const std::string& name, const std::string& help, std::function<double()> callback);
+
+        std::string render() const;
+
+        MetricCounter connectionsAccepted;
+        MetricCounter bytesReceived;
+        MetricCounter bytesSent;
+
+        MetricCounter loginsSucceeded;
+        MetricCounter loginsFailed;
+        MetricCounter loginsRejected;
+
+        MetricHistogram rsaDecryptTime;
+        MetricHistogram databaseQueryTime;
+        MetricHistogram redisPublishTime;
+
+        MetricHistogram dispatcherLag;
+        MetricHistogram luaCallbackTime;
+
+        MetricGauge luaMemory;
+        MetricHistogram luaGcCycleTime;
+
+    private:
+        enum class Type {
+            Counter,
+            Gauge,
+            Histogram,
+        };
+
+        struct Entry {
+            std::string name;
+            std::string help;
+            Type type;
+            // {label="value"} or empty
+            std::string labels;
+
+            const MetricCounter* counter = nullptr;
+            const MetricGauge* gauge = nullptr;
+            const MetricHistogram* histogram = nullptr;
+            std::function<double()> callback;
+        };
+
+        void add(Entry entry);
+
+        std::vector<Entry> m_entries;
+        mutable std::mutex m_lock;
+};
+
+extern Metrics g_metrics;
+
+#endif
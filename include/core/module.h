@@ -13,6 +13,7 @@
 #include <unordered_map>
 
 #include <script/lua.h>
+#include <script/luaallocator.h>
 #include <utils/types.h>
 
 class ModuleManager;
@@ -40,8 +41,13 @@ class Module {
         bool exportLua(const std::string& name, int32_t ref);
 
         std::string getName() { return m_name; }
+        const std::string& getPath() const { return m_path; }
+
+        // replaced by a reload, can not connect events anymore
+        bool isRetired() const { return m_retired; }
 
         int getSandboxEnv() const { return m_sandboxEnv; }
+        uint16_t getMemoryOwner() const { return m_memoryOwner; }
 
         const std::vector<int32_t>& getEventCallback(const std::string& event);
 
@@ -64,6 +70,8 @@ class Module {
         StringVector m_dependencies;
 
         int m_sandboxEnv = -1;
+        uint16_t m_memoryOwner = LuaAllocator::CORE_OWNER;
+        bool m_retired = false;
 
         ModuleManager* m_manager = nullptr;
 
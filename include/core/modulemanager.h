@@ -9,6 +9,7 @@
 #define CORE_MODULEMANAGER_H
 
 #include <core/module.h>
+#include <core/metrics.h>
 #include <script/lua.h>
 #include <utils/tools.h>
 
@@ -26,12 +27,14 @@ class ModuleManager
 
         template<typename... T>
         void emitNoRet(const std::string& event, const std::string& identifier = std::string(), T&&... args) {
+            std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
             if (identifier.empty()) {
                 if (m_moduleEvents.find(event) != m_moduleEvents.end()) {
                     auto& modules = m_moduleEvents[event];
 
                     for (auto& module : modules) {
                         for (int32_t callback : module->getEventCallback(event)) {
+                            CallbackScope scope(module, event, callback, identifier);
                             g_lua->callSandboxLuaFieldNoRet(callback, module->getSandboxEnv(), std::forward<T>(args)...);
                             checkConnectOnce(module, event, callback);
                         }
@@ -48,6 +51,7 @@ class ModuleManager
                     if (eventMap.find(identifier) != eventMap.end()) {
                         if (eventMap[identifier] != callback) {
                             callback = eventMap[identifier];
+                            CallbackScope scope(module, event, callback, identifier);
                             g_lua->callSandboxLuaFieldNoRet(callback, module->getSandboxEnv(), std::forward<T>(args)...);
                             checkConnectOnce(module, event, identifier);
                         }
@@ -57,6 +61,7 @@ class ModuleManager
         }
 
         int luaEmit(const std::string& event, int32_t tableRef, const std::string& identifier = std::string()) {
+            std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
             int ret = 0;
             std::vector<std::any> vecRet;
             lua_State* L = g_lua->getLuaState();
@@ -69,6 +74,7 @@ class ModuleManager
                         for (int32_t callback : module->getEventCallback(event)) {
                             vecRet.clear();
 
+                            CallbackScope scope(module, event, callback, identifier);
                             g_lua->callSandboxLuaFieldRef(callback, 1, vecRet, tableRef, module->getSandboxEnv());
 
                             if (vecRet.size() > 0) {
@@ -92,6 +98,7 @@ class ModuleManager
                         if (eventMap[identifier] != callback) {
                             callback = eventMap[identifier];
                             vecRet.clear();
+                            CallbackScope scope(module, event, callback, identifier);
                             g_lua->callSandboxLuaFieldRef(callback, 1, vecRet, tableRef, module->getSandboxEnv());
 
                             if (vecRet.size() > 0) {
@@ -111,12 +118,14 @@ class ModuleManager
 
         template<typename... T>
         void emit(const std::string& event, int nresults, std::vector<std::any>& vecRet, const std::string& identifier = std::string(), T&&... args) {
+            std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
             if (identifier.empty()) {
                 if (m_moduleEvents.find(event) != m_moduleEvents.end()) {
                     auto& modules = m_moduleEvents[event];
 
                     for (auto& module : modules) {
                         for (int32_t callback : module->getEventCallback(event)) {
+                            CallbackScope scope(module, event, callback, identifier);
                             g_lua->callSandboxLuaField(callback, nresults, vecRet, module->getSandboxEnv(), std::forward<T>(args)...);
                             checkConnectOnce(module, event, callback);
                         }
@@ -133,6 +142,7 @@ class ModuleManager
                     if (eventMap.find(identifier) != eventMap.end()) {
                         if (eventMap[identifier] != callback) {
                             callback = eventMap[identifier];
+                            CallbackScope scope(module, event, callback, identifier);
                             g_lua->callSandboxLuaField(callback, nresults, vecRet, module->getSandboxEnv(), std::forward<T>(args)...);
                             checkConnectOnce(module, event, identifier);
                         }
@@ -144,6 +154,13 @@ class ModuleManager
         void removeAllConnectionsById(const std::string& identifier);
         bool loadModules();
 
+        // loads the module again into a fresh sandbox env and swaps it in
+        // place of the running one, the old version stays on failure;
+        // holds the Lua lock, so no emit on the io thread sees a half swap
+        bool reloadModule(const std::string& name);
+        // every loaded module, in load order
+        void reloadModules();
+
         void checkConnectOnce(Module* module, const std::string& event, int32_t callback);
         void checkConnectOnce(Module* module, const std::string& event, const std::string& identifier);
 
@@ -151,10 +168,38 @@ class ModuleManager
         Module* getModuleByName(const std::string& name);
 
     private:
+        // metrics, profiler, watchdog budget and allocator owner of one module callback
+        struct CallbackScope {
+            CallbackScope(Module* module, const std::string& event, int32_t callback, const std::string& identifier) :
+                callbackTimer(g_metrics.luaCallbackTime),
+                callTimer(g_lua->getProfiler(), module, event, identifier),
+                budget(g_lua->getWatchdog(), g_lua->getLuaState(), module, module->getMemoryOwner(), event, callback, identifier),
+                memoryScope(g_lua->getAllocator(), module->getMemoryOwner()) {}
+
+            MetricTimer callbackTimer;
+            LuaProfiler::CallTimer callTimer;
+            LuaWatchdog::Scope budget;
+            LuaAllocator::OwnerScope memoryScope;
+        };
+
+        void swapEventModules(Module* oldModule, Module* newModule);
+        // drops the registry references of a replaced version and tracks its env
+        void retireModule(Module* module);
+        // deletes the retired versions whose env was collected
+        void releaseRetiredModules();
+
         std::unordered_map<Module*, std::unordered_map<std::string, int32_t>> m_moduleExports;
         std::unordered_map<std::string, std::vector<Module*>> m_moduleEvents;
         std::unordered_map<std::string, std::vector<Module*>> m_identifiedModuleEvents;
         std::unordered_map<std::string, Module*> m_modules;
+        std::vector<std::string> m_loadOrder;
+
+        // replaced by a reload, kept until no coroutine or closure of theirs
+        // is left: weak tables keyed by the Module* hold their sandbox env
+        // and `module` userdata, the env is gone once Lua collected it
+        std::vector<Module*> m_retiredModules;
+        int32_t m_retiredEnvs = -1;
+        int32_t m_retiredHandles = -1;
 
     friend class Module;
 };
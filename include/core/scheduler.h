@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef CORE_SCHEDULER_H
+#define CORE_SCHEDULER_H
+
+#include <condition_variable>
+#include <queue>
+#include <unordered_set>
+
+#include <core/tasks.h>
+
+static constexpr int32_t SCHEDULER_MINTICKS = 50;
+
+class SchedulerTask : public Task
+{
+public:
+	void setEventId(uint32_t id) {
+		m_eventId = id;
+	}
+
+	uint32_t getEventId() const {
+		return m_eventId;
+	}
+
+	std::chrono::system_clock::time_point getCycle() const {
+		return m_expiration;
+	}
+
+protected:
+	SchedulerTask(uint32_t delay, TaskFunc&& f) : Task(delay, std::move(f)) {}
+
+	uint32_t m_eventId = 0;
+
+	friend SchedulerTask* createSchedulerTask(uint32_t, TaskFunc&&);
+};
+
+SchedulerTask* createSchedulerTask(uint32_t delay, TaskFunc&& f);
+
+struct TaskComparator {
+	bool operator()(const SchedulerTask* lhs, const SchedulerTask* rhs) const {
+		return lhs->getCycle() > rhs->getCycle();
+	}
+};
+
+// Delayed tasks, moved to the dispatcher once their time has come
+class Scheduler : public ThreadHolder<Scheduler>
+{
+public:
+	uint32_t addEvent(SchedulerTask* task);
+	bool stopEvent(uint32_t eventId);
+
+	void shutdown();
+
+	void threadMain();
+
+private:
+	std::mutex m_eventLock;
+	std::condition_variable m_eventSignal;
+
+	uint32_t m_lastEventId = 0;
+	std::priority_queue<SchedulerTask*, std::deque<SchedulerTask*>, TaskComparator> m_eventList;
+	std::unordered_set<uint32_t> m_eventIds;
+};
+
+extern Scheduler g_scheduler;
+
+#endif
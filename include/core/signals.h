@@ -23,6 +23,11 @@ class Signals
         void dispatchSignalHandler(int signal);
 
         void sigintHandler();
+#ifndef _WIN32
+        void sighupHandler();
+        void sigusr1Handler();
+        void sigusr2Handler();
+#endif
 };
 
 #endif
@@ -8,6 +8,7 @@
 #ifndef CORE_TASKS_H
 #define CORE_TASKS_H
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <chrono>
@@ -15,6 +16,8 @@
 #include <core/threadholder.h>
 
 using TaskFunc = std::function<void(void)>;
+// runs while the task queue is empty, returns true while it has more work
+using IdleHandler = std::function<bool(void)>;
 const int DISPATCHER_TASK_EXPIRATION = 2000;
 const auto SYSTEM_TIME_ZERO = std::chrono::system_clock::time_point(std::chrono::milliseconds(0));
 
@@ -43,8 +46,17 @@ public:
 		return m_expiration < std::chrono::system_clock::now();
 	}
 
+	// set by Dispatcher::addTask, the queue lag is measured from it
+	void setEnqueued() {
+		m_enqueued = std::chrono::steady_clock::now();
+	}
+	std::chrono::steady_clock::time_point getEnqueued() const {
+		return m_enqueued;
+	}
+
 protected:
 	std::chrono::system_clock::time_point m_expiration = SYSTEM_TIME_ZERO;
+	std::chrono::steady_clock::time_point m_enqueued;
 
 private:
 	// Expiration has another meaning for scheduler tasks,
@@ -62,8 +74,24 @@ public:
 
 	void shutdown();
 
+	// has to be set before the thread is started
+	void setIdleHandler(IdleHandler handler) {
+		m_idleHandler = std::move(handler);
+	}
+
+	// read by the metrics endpoint on the HTTP thread
 	uint64_t getDispatcherCycle() const {
-		return m_dispatcherCycle;
+		return m_dispatcherCycle.load(std::memory_order_relaxed);
+	}
+
+	// us the last executed task waited in the queue
+	uint32_t getLastLag() const {
+		return m_lastLag.load(std::memory_order_relaxed);
+	}
+
+	size_t getQueueSize() {
+		std::lock_guard<std::mutex> lockClass(m_taskLock);
+		return m_taskList.size();
 	}
 
 	void threadMain();
@@ -73,7 +101,11 @@ private:
 	std::condition_variable m_taskSignal;
 
 	std::vector<Task*> m_taskList;
-	uint64_t m_dispatcherCycle = 0;
+	std::atomic<uint64_t> m_dispatcherCycle{0};
+	std::atomic<uint32_t> m_lastLag{0};
+
+	IdleHandler m_idleHandler;
+	bool m_idleWork = false;
 };
 
 extern Dispatcher g_dispatcher;
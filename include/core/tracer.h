@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef CORE_TRACER_H
+#define CORE_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Sampled spans of the login pipeline, exported as a Chrome trace
+ * (chrome://tracing, ui.perfetto.dev) by /trace on the HTTP port.
+ *
+ * One in traceSampleRate connections gets a trace id. Code running for a
+ * traced connection sets it as the thread's current trace (TraceContext),
+ * spans opened on that thread (TraceSpan) are recorded under it without
+ * passing the id down; everything else costs one thread_local read.
+ *
+ * Spans go into a fixed ring per thread, the oldest are overwritten. Span
+ * names have to be string literals, only the pointer is stored.
+ */
+class Tracer
+{
+    public:
+        Tracer() = default;
+
+        // non-copyable
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        // rate: trace one in rate connections, 0 disables; capacity: spans per thread
+        void setup(uint32_t sampleRate, size_t capacity);
+
+        bool isEnabled() const {
+            return m_sampleRate != 0;
+        }
+
+        // new trace id, 0 when the connection is not sampled
+        uint64_t sample();
+
+        static uint64_t getCurrentTrace() {
+            return s_currentTrace;
+        }
+
+        // nanoseconds on the tracer clock
+        static int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // span on the calling thread
+        void record(uint64_t trace, const char* name, int64_t start, int64_t end);
+        // span not bound to a thread (a wait, an async round trip), shown on the trace's own track
+        void recordAsync(uint64_t trace, const char* name, int64_t start, int64_t end);
+
+        // Chrome JSON trace of everything still in the rings
+        std::string dump() const;
+        void clear();
+
+    private:
+        struct Span {
+            const char* name;
+            uint64_t trace;
+            int64_t start;
+            int64_t end;
+            bool async;
+        };
+
+        struct Ring {
+            // only contended while dumping
+            mutable std::mutex lock;
+            std::vector<Span> spans;
+            size_t next = 0;
+            uint32_t tid = 0;
+        };
+
+        void push(const Span& span);
+        Ring& getRing();
+
+        uint32_t m_sampleRate = 0;
+        size_t m_capacity = 0;
+        std::atomic<uint64_t> m_connections{0};
+
+        mutable std::mutex m_ringsLock;
+        std::vector<std::unique_ptr<Ring>> m_rings;
+
+        static thread_local uint64_t s_currentTrace;
+        static thread_local Ring* s_ring;
+
+        friend class TraceContext;
+};
+
+extern Tracer g_tracer;
+
+// makes trace the current trace of the thread for the scope
+class TraceContext
+{
+    public:
+        explicit TraceContext(uint64_t trace) : m_previous(Tracer::s_currentTrace) {
+            Tracer::s_currentTrace = trace;
+        }
+        ~TraceContext() {
+            Tracer::s_currentTrace = m_previous;
+        }
+
+        // non-copyable
+        TraceContext(const TraceContext&) = delete;
+        TraceContext& operator=(const TraceContext&) = delete;
+
+    private:
+        uint64_t m_previous;
+};
+
+// records the scope as a span of the current trace, if there is one
+class TraceSpan
+{
+    public:
+        explicit TraceSpan(const char* name) : m_name(name), m_trace(Tracer::getCurrentTrace()) {
+            if (m_trace != 0) {
+                m_start = Tracer::now();
+            }
+        }
+        ~TraceSpan() {
+            if (m_trace != 0) {
+                g_tracer.record(m_trace, m_name, m_start, Tracer::now());
+            }
+        }
+
+        // non-copyable
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_trace;
+        int64_t m_start = 0;
+};
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef DATABASE_ACCOUNTSTORE_H
+#define DATABASE_ACCOUNTSTORE_H
+
+#include <utils/types.h>
+
+struct Character {
+    std::string name;
+    std::string instanceName;
+    std::string instanceId;
+    uint16_t level;
+    bool autoReconnect;
+};
+
+struct Account {
+    uint16_t id = 0;
+    std::string email;
+    std::string password;
+    uint64_t premiumEnd;
+};
+
+/**
+ * Where Protocol::authenticate looks up accounts, selected by accountStore in
+ * config.lua: "mysql" (MySQLAccountStore) or "memory" (MemoryAccountStore).
+ * Both are called from the network threads and have to be thread-safe.
+ */
+class AccountStore
+{
+    public:
+        virtual ~AccountStore() = default;
+
+        virtual const char* getName() const = 0;
+
+        // id is 0 when the email or password do not match; the characters are
+        // read separately, Protocol goes through g_characterListCache first
+        virtual Account getAccount(const std::string& email, const std::string& password) = 0;
+        virtual std::vector<Character> getCharacterList(uint16_t accountId) = 0;
+
+    protected:
+        // SHA1 of encryptionSalt + password, as stored in accounts.password
+        static std::string hashPassword(const std::string& password);
+};
+
+extern AccountStorePtr g_accountStore;
+
+#endif
@@ -12,22 +12,6 @@
 
 #include <utils/types.h>
 
-struct Character {
-    std::string name;
-    std::string instanceName;
-    std::string instanceId;
-    uint16_t level;
-    bool autoReconnect;
-};
-
-struct Account {
-    uint16_t id = 0;
-    std::string email;
-    std::string password;
-    uint64_t premiumEnd;
-    std::vector<Character> characters;
-};
-
 class Database
 {
     public:
@@ -40,22 +24,29 @@ class Database
 
         void connect();
         void disconnect();
+        // nullptr on errors and when there are no rows
         DBResultSharedPtr storeQuery(const std::string& query);
+        // streams the rows for large results, the connection stays locked
+        // for this thread until the result is destroyed, other queries fail meanwhile
+        DBResultPtr useQuery(const std::string& query);
 
         std::string getVersion() const {
             return mysql_get_client_info();
         }
 
-        std::string escapeString(const std::string& string) const;
+        bool isConnected() const {
+            return m_handle != nullptr;
+        }
 
-        Account getAccount(const std::string& email, const std::string& password);
+        std::string escapeString(const std::string& string) const;
 
     private:
-        DBResultSharedPtr getAccountInfo(const std::string& email, const std::string& password);
-        std::vector<Character> getCharacterList(uint16_t accountId);
+        bool executeQuery(const std::string& query, std::unique_lock<std::recursive_mutex>& lock);
 
         MYSQL* m_handle = nullptr;
         std::recursive_mutex m_databaseLock;
+        // a useQuery result is unread, guarded by m_databaseLock
+        bool m_streaming = false;
 };
 
 extern Database g_database;
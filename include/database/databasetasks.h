@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef DATABASE_DATABASETASKS_H
+#define DATABASE_DATABASETASKS_H
+
+#include <condition_variable>
+#include <list>
+
+#include <core/threadholder.h>
+#include <utils/types.h>
+
+// Queries run on their own thread, callbacks on the dispatcher thread
+class DatabaseTasks : public ThreadHolder<DatabaseTasks>
+{
+    public:
+        using Callback = std::function<void(DBResultSharedPtr)>;
+
+        // false when the thread is not running (no database connection)
+        bool addTask(std::string query, Callback callback);
+
+        void shutdown();
+
+        void threadMain();
+
+    private:
+        struct DatabaseTask {
+            std::string query;
+            Callback callback;
+        };
+
+        std::mutex m_taskLock;
+        std::condition_variable m_taskSignal;
+        std::list<DatabaseTask> m_tasks;
+};
+
+extern DatabaseTasks g_databaseTasks;
+
+#endif
@@ -8,51 +8,177 @@
 #ifndef DATABASE_DBRESULT
 #define DATABASE_DBRESULT
 
-#include <boost/lexical_cast.hpp>
+#include <charconv>
+#include <string_view>
 
+/**
+ * Rows of a query, read straight from the MYSQL_RES which is freed with the
+ * result. Columns are looked up by index, getColumnIndex resolves a name once
+ * per query instead of once per cell.
+ *
+ * Stored results (Database::storeQuery) hold every row in memory and can be
+ * passed to other threads. Streaming results (Database::useQuery) fetch one
+ * row at a time and keep the connection locked until they are destroyed, other
+ * queries fail until then, even on the thread that owns the result.
+ */
 class DBResult {
     public:
-        explicit DBResult(MYSQL_RES* res);
-        ~DBResult() = default;
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        // streaming is cleared when the result is destroyed, before the lock is released
+        explicit DBResult(MYSQL_RES* res, std::unique_lock<std::recursive_mutex> connectionLock = {}, bool* streaming = nullptr);
+        ~DBResult();
 
         // non-copyable
         DBResult(const DBResult&) = delete;
         DBResult& operator=(const DBResult&) = delete;
 
         void next() {
-            m_index++;
+            m_row = mysql_fetch_row(m_handle);
+            m_lengths = m_row ? mysql_fetch_lengths(m_handle) : nullptr;
+        }
+        bool hasNext() const {
+            return m_row != nullptr;
+        }
+
+        // npos when the query has no such column
+        size_t getColumnIndex(std::string_view name) const;
+
+        // column names by index, for consumers that read every column (Lua db.query)
+        const std::vector<std::string>& getColumns() const {
+            return m_columns;
+        }
+
+        // nullptr for NULL
+        const char* getValue(size_t column) const {
+            return m_row && column < m_columns.size() ? m_row[column] : nullptr;
+        }
+
+        // bytes of the value, binary columns may hold '\0'; 0 for NULL
+        size_t getLength(size_t column) const {
+            return getValue(column) ? m_lengths[column] : 0;
+        }
+
+        // empty for NULL, valid until next()
+        std::string_view getStringView(size_t column) const {
+            const char* value = getValue(column);
+            return value ? std::string_view(value, m_lengths[column]) : std::string_view();
+        }
+
+        std::string getString(size_t column) const {
+            return std::string(getStringView(column));
         }
-        bool hasNext() {
-            return (m_index < m_rows.size());
+
+        std::string getString(std::string_view field) const {
+            return getString(getColumnIndex(field));
         }
 
-        std::string getString(const std::string& field);
+        // T{} for NULL and values that are not a number
+        template<typename T>
+        T getNumber(size_t column) const {
+            T value{};
+            convert(getValue(column), getLength(column), value);
+            return value;
+        }
 
         template<typename T>
-        T getNumber(const std::string& field)
-        {
-            if (m_rows.empty() || m_index >= m_rows.size()) {
-                return T{};
+        T getNumber(std::string_view field) const {
+            return getNumber<T>(getColumnIndex(field));
+        }
+
+        // value and length as getValue and getLength return them
+        static void convert(const char* value, size_t length, std::string& out) {
+            if (value) {
+                out.assign(value, length);
+            } else {
+                out.clear();
             }
+        }
+
+        static void convert(const char* value, size_t length, bool& out) {
+            int number = 0;
+            convert(value, length, number);
+            out = number != 0;
+        }
 
-            auto it = m_fields.find(field);
-            if (it == m_fields.end()) {
-                return T{};
+        template<typename T>
+        static void convert(const char* value, size_t length, T& out) {
+            static_assert(std::is_arithmetic_v<T>, "DBResult::convert needs a number or a std::string");
+            if (!value) {
+                return;
             }
 
-            auto row = m_rows[m_index];
-            try {
-                return boost::lexical_cast<T>(row[it->second]);
-            } catch (const boost::bad_lexical_cast&) {
-                return T{};
+            if constexpr (std::is_integral_v<T>) {
+                std::from_chars(value, value + length, out);
+            } else {
+                out = static_cast<T>(std::strtod(value, nullptr));
             }
         }
 
+        // gives the MYSQL_RES back without freeing it
+        MYSQL_RES* release();
 
     private:
-        std::map<std::string, size_t> m_fields;
-        std::vector<MYSQL_ROW> m_rows;
-        size_t m_index = 0;
+        MYSQL_RES* m_handle;
+        MYSQL_ROW m_row = nullptr;
+        // mysql_fetch_lengths of m_row
+        unsigned long* m_lengths = nullptr;
+        std::vector<std::string> m_columns;
+        std::unique_lock<std::recursive_mutex> m_connectionLock;
+        bool* m_streaming;
+};
+
+/**
+ * Columns of a query bound to the members of a row struct, resolved once
+ * per result:
+ *
+ *   static const DBBinding<Character> binding = DBBinding<Character>()
+ *       .bind("name", &Character::name)
+ *       .bind("level", &Character::level);
+ *   std::vector<Character> characters = binding.readAll(*result);
+ *
+ * Members can be std::string, bool or numbers; columns missing from the
+ * query leave the member as it is.
+ */
+template<typename Row>
+class DBBinding
+{
+    public:
+        template<typename T>
+        DBBinding& bind(const char* column, T Row::* member) {
+            m_fields.push_back({column, [member](Row& row, const char* value, size_t length) {
+                DBResult::convert(value, length, row.*member);
+            }});
+            return *this;
+        }
+
+        // reads the current row and every one after it
+        std::vector<Row> readAll(DBResult& result) const {
+            std::vector<size_t> indices;
+            indices.reserve(m_fields.size());
+            for (const Field& field : m_fields) {
+                indices.push_back(result.getColumnIndex(field.column));
+            }
+
+            std::vector<Row> rows;
+            for (; result.hasNext(); result.next()) {
+                Row& row = rows.emplace_back();
+                for (size_t i = 0; i < m_fields.size(); ++i) {
+                    if (indices[i] != DBResult::npos) {
+                        m_fields[i].read(row, result.getValue(indices[i]), result.getLength(indices[i]));
+                    }
+                }
+            }
+            return rows;
+        }
+
+    private:
+        struct Field {
+            const char* column;
+            std::function<void(Row&, const char*, size_t)> read;
+        };
+
+        std::vector<Field> m_fields;
 };
 
 #endif
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef DATABASE_MEMORYACCOUNTSTORE_H
+#define DATABASE_MEMORYACCOUNTSTORE_H
+
+#include <unordered_map>
+
+#include <database/accountstore.h>
+
+/**
+ * Read-only accounts loaded once from a tab separated file, for benchmarks
+ * and test shards that should not need MySQL:
+ *
+ *   account <id> <email> <password> <premium_ends_at>
+ *   player <account_id> <name> <level> <instance_id> <instance_name> <auto_reconnect>
+ *
+ * password is the accounts.password hash, or "plain:<password>" for
+ * hand-written files. Blank lines and lines starting with # are skipped.
+ * Nothing changes after load, so lookups take no lock.
+ */
+class MemoryAccountStore : public AccountStore
+{
+    public:
+        const char* getName() const override {
+            return "memory";
+        }
+
+        // throws std::runtime_error naming the file and line
+        void load(const std::string& path);
+
+        // every lookup sleeps latency + [0, jitter] us, like a database round trip
+        void setLatency(uint32_t latency, uint32_t jitter) {
+            m_latency = latency;
+            m_jitter = jitter;
+        }
+
+        size_t getAccountCount() const {
+            return m_accounts.size();
+        }
+
+        Account getAccount(const std::string& email, const std::string& password) override;
+        std::vector<Character> getCharacterList(uint16_t accountId) override;
+
+    private:
+        struct AccountEntry {
+            uint16_t id;
+            std::string password;
+            bool plain;
+            uint64_t premiumEnd;
+        };
+
+        void simulateLatency() const;
+
+        std::unordered_map<std::string, AccountEntry> m_accounts;
+        std::unordered_map<uint16_t, std::vector<Character>> m_characters;
+        uint32_t m_latency = 0;
+        uint32_t m_jitter = 0;
+};
+
+#endif
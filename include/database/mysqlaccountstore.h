@@ -0,0 +1,28 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef DATABASE_MYSQLACCOUNTSTORE_H
+#define DATABASE_MYSQLACCOUNTSTORE_H
+
+#include <database/accountstore.h>
+
+// accounts and players tables through g_database
+class MySQLAccountStore : public AccountStore
+{
+    public:
+        const char* getName() const override {
+            return "mysql";
+        }
+
+        Account getAccount(const std::string& email, const std::string& password) override;
+        std::vector<Character> getCharacterList(uint16_t accountId) override;
+
+    private:
+        DBResultSharedPtr getAccountInfo(const std::string& email, const std::string& password);
+};
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef NETWORK_CHARACTERLISTCACHE_H
+#define NETWORK_CHARACTERLISTCACHE_H
+
+#include <atomic>
+
+#include <database/accountstore.h>
+
+/**
+ * Serialized characters of the CharacterList packet per account, so a login
+ * that finds its account here skips the players query and the encoding.
+ *
+ * Game servers publish the account id (or "*" for all of them) on
+ * characterListCacheChannel when characters change; characterListCacheTtl
+ * bounds how long a missed message leaves a stale list. Every invalidation
+ * bumps the version of the account, so a list loaded before it is not stored.
+ * A full cache evicts the least recently used account.
+ */
+class CharacterListCache
+{
+    public:
+        using Payload = std::shared_ptr<const std::string>;
+
+        CharacterListCache() = default;
+
+        // non-copyable
+        CharacterListCache(const CharacterListCache&) = delete;
+        CharacterListCache& operator=(const CharacterListCache&) = delete;
+
+        // capacity 0 disables the cache, ttl in seconds
+        void setup(size_t capacity, uint32_t ttl, const std::string& channel);
+
+        bool isEnabled() const {
+            return m_capacity != 0;
+        }
+
+        const std::string& getChannel() const {
+            return m_channel;
+        }
+
+        // nullptr on a miss, version has to be passed to put() with the loaded list
+        Payload get(uint16_t accountId, uint64_t& version);
+        void put(uint16_t accountId, uint64_t version, Payload payload);
+        // drops the entry get() made for a load that is not put()
+        void discard(uint16_t accountId, uint64_t version);
+
+        void invalidate(uint16_t accountId);
+        void clear();
+
+        // message from the invalidation channel
+        void handleMessage(const std::string& message);
+
+        // List<uint8_t, Packets::Character> as written after the opcode
+        static Payload serialize(const std::vector<Character>& characters);
+
+        uint64_t getHits() const {
+            return m_hits.load(std::memory_order_relaxed);
+        }
+        uint64_t getMisses() const {
+            return m_misses.load(std::memory_order_relaxed);
+        }
+        uint64_t getInvalidations() const {
+            return m_invalidations.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Entry {
+            Payload payload;
+            uint64_t version;
+            std::chrono::steady_clock::time_point expires;
+            std::list<uint16_t>::iterator position;
+        };
+
+        Entry& getEntry(uint16_t accountId);
+
+        std::mutex m_mutex;
+        std::unordered_map<uint16_t, Entry> m_entries;
+        // account ids, most recently used first
+        std::list<uint16_t> m_order;
+        uint64_t m_version = 0;
+
+        size_t m_capacity = 0;
+        std::chrono::seconds m_ttl{0};
+        std::string m_channel;
+
+        std::atomic<uint64_t> m_hits{0};
+        std::atomic<uint64_t> m_misses{0};
+        std::atomic<uint64_t> m_invalidations{0};
+};
+
+extern CharacterListCache g_characterListCache;
+
+#endif
@@ -67,6 +67,12 @@ class Connection : public std::enable_shared_from_this<Connection>
 
         uint64_t m_id = 0;
 
+        // g_tracer trace of the connection, 0 when not sampled
+        uint64_t m_traceId = 0;
+        int64_t m_acceptTime = 0;
+        int64_t m_readStart = 0;
+        int64_t m_writeStart = 0;
+
         friend class ConnectionManager;
         friend class Server;
 };
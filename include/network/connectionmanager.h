@@ -30,6 +30,8 @@ class ConnectionManager
 
         ProtocolSharedPtr getProtocolById(uint64_t ip);
 
+        size_t getConnectionCount();
+
     protected:
         std::unordered_set<ConnectionSharedPtr> m_connections;
         std::mutex m_connectionManagerLock;
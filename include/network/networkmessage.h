@@ -8,6 +8,8 @@
 #ifndef NETWORK_NETWORKMESSAGE_H
 #define NETWORK_NETWORKMESSAGE_H
 
+#include <string_view>
+
 static constexpr int32_t NETWORKMESSAGE_MAXSIZE = 24590;
 
 class NetworkMessage
@@ -59,6 +61,10 @@ class NetworkMessage
 
         std::string getString(uint16_t stringLen = 0);
 
+        // same as getString without the copy, points into the buffer and is
+        // only valid until the message is reset or written again
+        std::string_view getStringView(uint16_t stringLen = 0);
+
         // skips count unknown/unused bytes in an incoming message
         void skipBytes(int16_t count) {
             m_info.position += count;
@@ -85,10 +91,45 @@ class NetworkMessage
             m_info.length += sizeof(T);
         }
 
+        // raw access for the packet codecs (network/packetschema.h), which
+        // validate a whole packet with a single bounds check
+        const uint8_t* getReadCursor() const {
+            return m_buffer + m_info.position;
+        }
+
+        size_t getReadableBytes() const {
+            // same limits as canRead
+            const int32_t byLength = (m_info.length + 8) - m_info.position;
+            const int32_t byBuffer = (NETWORKMESSAGE_MAXSIZE - 1) - m_info.position;
+            return static_cast<size_t>(std::max<int32_t>(0, std::min(byLength, byBuffer)));
+        }
+
+        const uint8_t* readBytes(size_t size) {
+            if (size > NETWORKMESSAGE_MAXSIZE || !canRead(static_cast<int32_t>(size))) {
+                m_info.overrun = true;
+                return nullptr;
+            }
+
+            const uint8_t* data = m_buffer + m_info.position;
+            m_info.position += size;
+            return data;
+        }
+
+        uint8_t* reserveBytes(size_t size) {
+            if (!canAdd(size)) {
+                return nullptr;
+            }
+
+            uint8_t* data = m_buffer + m_info.position;
+            m_info.position += size;
+            m_info.length += size;
+            return data;
+        }
+
         void addBytes(const char* bytes, size_t size);
         void addPaddingBytes(size_t n);
 
-        void addString(const std::string& value);
+        void addString(std::string_view value);
 
         void addDouble(double value, uint8_t precision = 2);
 
@@ -129,6 +170,16 @@ class NetworkMessage
 
         static const uint8_t headerLength = 2;
 
+        // memory layout exported to the LuaJIT FFI binding (lib/networkmessage.lua)
+        struct Layout {
+            size_t length;
+            size_t position;
+            size_t overrun;
+            size_t buffer;
+        };
+
+        static Layout getLayout();
+
     protected:
         bool canAdd(size_t size) const {
             return (size + m_info.position) < MAX_BODY_LENGTH;
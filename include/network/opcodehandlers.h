@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef NETWORK_OPCODEHANDLERS_H
+#define NETWORK_OPCODEHANDLERS_H
+
+#include <array>
+#include <functional>
+
+#include <utils/types.h>
+
+/**
+ * Native handlers for client opcodes, run by Protocol::parsePacket on the
+ * io thread. Opcodes without a native handler are emitted to the Lua
+ * modules (onReceiveNetworkMessage).
+ *
+ * Handlers are registered once at startup and only read afterwards.
+ */
+class OpcodeHandlers
+{
+    public:
+        using Handler = std::function<void(const ProtocolSharedPtr&, NetworkMessage&)>;
+
+        OpcodeHandlers() = default;
+
+        // non-copyable
+        OpcodeHandlers(const OpcodeHandlers&) = delete;
+        OpcodeHandlers& operator=(const OpcodeHandlers&) = delete;
+
+        // registers the built-in handlers, then gives the opcodes listed in
+        // luaOpcodes (config.lua) back to the Lua modules
+        void init();
+
+        void registerHandler(uint8_t opcode, const std::string& name, Handler handler);
+        void removeHandler(uint8_t opcode);
+
+        bool handle(uint8_t opcode, const ProtocolSharedPtr& protocol, NetworkMessage& msg) const {
+            const Handler& handler = m_handlers[opcode];
+            if (!handler) {
+                return false;
+            }
+
+            handler(protocol, msg);
+            return true;
+        }
+
+        bool hasHandler(uint8_t opcode) const {
+            return static_cast<bool>(m_handlers[opcode]);
+        }
+
+    private:
+        std::array<Handler, 256> m_handlers;
+        std::array<std::string, 256> m_names;
+};
+
+extern OpcodeHandlers g_opcodeHandlers;
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef NETWORK_PACKETFORMAT_H
+#define NETWORK_PACKETFORMAT_H
+
+#include <string>
+#include <vector>
+
+// Compiled field list of a format string such as "u8 s u16", used by the
+// bulk NetworkMessage:read/write Lua bindings.
+class PacketFormat
+{
+    public:
+        enum class FieldType : uint8_t {
+            U8,
+            U16,
+            U32,
+            U64,
+            String,
+        };
+
+        // upper bound of fields in one pattern, keeps the Lua stack bounded
+        static constexpr size_t MAX_FIELDS = 64;
+
+        PacketFormat() = default;
+
+        // non-copyable
+        PacketFormat(const PacketFormat&) = delete;
+        PacketFormat& operator=(const PacketFormat&) = delete;
+
+        // Returns the compiled format, parsing the pattern only the first time
+        // it is seen. Invalid patterns are cached too and return nullptr.
+        // Patterns are expected to be constants, the cache is never trimmed.
+        static const PacketFormat* get(const std::string& pattern);
+
+        const std::vector<FieldType>& getFields() const {
+            return m_fields;
+        }
+
+        size_t size() const {
+            return m_fields.size();
+        }
+
+    private:
+        bool compile(const std::string& pattern);
+
+        std::vector<FieldType> m_fields;
+};
+
+#endif
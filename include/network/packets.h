@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef NETWORK_PACKETS_H
+#define NETWORK_PACKETS_H
+
+#include <network/packetschema.h>
+#include <network/protocol.h>
+
+/**
+ * Login protocol packets. FIELDS names every field in wire order, the Lua
+ * bindings (Packet.<Name>) are generated from the same definitions.
+ */
+namespace Packets
+{
+    using namespace PacketSchema;
+
+    // client -> server, plain part of the first packet
+    struct LoginHeader : Schema<Skip<2>, U16, Skip<17>>
+    {
+        // 17 bytes: protocol version, dat/spr/pic signatures and a 0 byte
+        static constexpr const char* FIELDS[] = {"operatingSystem", "version", "signatures"};
+    };
+
+    // client -> server, RSA encrypted part of the first packet
+    struct LoginCredentials : Schema<Array<uint32_t, 4>, String, String>
+    {
+        static constexpr const char* FIELDS[] = {"key", "email", "password"};
+    };
+
+    // server -> client
+    struct Error : Message<Opcode::Error, String>
+    {
+        static constexpr const char* FIELDS[] = {"message"};
+    };
+
+    struct Motd : Message<Opcode::Motd, String>
+    {
+        static constexpr const char* FIELDS[] = {"message"};
+    };
+
+    struct SessionKey : Message<Opcode::SessionKey, String>
+    {
+        static constexpr const char* FIELDS[] = {"sessionKey"};
+    };
+
+    struct LoadingMessage : Message<Opcode::LoadingMessage, String>
+    {
+        static constexpr const char* FIELDS[] = {"message"};
+    };
+
+    struct Character : Schema<String, String, String, U16, U8>
+    {
+        static constexpr const char* FIELDS[] = {"name", "instanceName", "instanceId", "level", "autoReconnect"};
+    };
+
+    struct CharacterList : Message<Opcode::CharacterList, List<uint8_t, Character>, U8, U8, U32>
+    {
+        static constexpr const char* FIELDS[] = {"characters", "reserved", "premium", "premiumEnd"};
+    };
+
+    // CharacterList as Protocol::addCharacterList writes it: the characters
+    // come serialized from network/characterlistcache.h, the premium fields
+    // are encoded for every login
+    using CharacterListCharacters = List<uint8_t, Character>;
+    using CharacterListPremium = Schema<U8, U8, U32>;
+
+    // client -> server request and server -> client answer of the custom
+    // opcode handled by modules/login
+    struct GameServerHostRequest : Message<Opcode::GameServerHost, String, String>
+    {
+        static constexpr const char* FIELDS[] = {"instanceName", "instanceId"};
+    };
+
+    struct GameServerHost : Message<Opcode::GameServerHost, String, U16>
+    {
+        static constexpr const char* FIELDS[] = {"host", "port"};
+    };
+}
+
+#endif
@@ -0,0 +1,382 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef NETWORK_PACKETSCHEMA_H
+#define NETWORK_PACKETSCHEMA_H
+
+#include <network/networkmessage.h>
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <tuple>
+
+/**
+ * Declarative packet layouts. A schema lists its fields in wire order and
+ * the codecs are generated from it at compile time:
+ *
+ *   using Credentials = Schema<Array<uint32_t, 4>, String, String>;
+ *
+ *   Credentials::Values values;
+ *   if (Credentials::decode(msg, values)) { auto& [key, email, password] = values; ... }
+ *
+ * Decoding measures the packet first and then consumes it with a single
+ * bounds check, strings are returned as views into the message buffer.
+ * Encoding computes the exact size up front, reserves it with a single
+ * bounds check and writes the fields unchecked.
+ *
+ * Every field type provides:
+ *   Type                                  decoded value
+ *   MIN_SIZE, FIXED                       wire size information
+ *   LUA_VALUES                            values it takes on the Lua stack
+ *   valid(value)                          false when the value can not be encoded
+ *   size(value)                           encoded size
+ *   measure(in, available)                size on the wire or TRUNCATED
+ *   read(in, value), write(out, value)    unchecked codecs
+ */
+namespace PacketSchema
+{
+    // returned by measure() when the buffer ends before the field
+    static constexpr size_t TRUNCATED = std::numeric_limits<size_t>::max();
+
+    template<typename T>
+    struct Number
+    {
+        using Type = T;
+        static constexpr size_t MIN_SIZE = sizeof(T);
+        static constexpr bool FIXED = true;
+        static constexpr int LUA_VALUES = 1;
+
+        static bool valid(const Type&) {
+            return true;
+        }
+
+        static size_t size(const Type&) {
+            return sizeof(T);
+        }
+
+        static size_t measure(const uint8_t*, size_t available) {
+            return available < sizeof(T) ? TRUNCATED : sizeof(T);
+        }
+
+        static void read(const uint8_t*& in, Type& value) {
+            memcpy(&value, in, sizeof(T));
+            in += sizeof(T);
+        }
+
+        static void write(uint8_t*& out, const Type& value) {
+            memcpy(out, &value, sizeof(T));
+            out += sizeof(T);
+        }
+    };
+
+    using U8 = Number<uint8_t>;
+    using U16 = Number<uint16_t>;
+    using U32 = Number<uint32_t>;
+    using U64 = Number<uint64_t>;
+
+    template<typename T, size_t N>
+    struct Array
+    {
+        using Type = std::array<T, N>;
+        static constexpr size_t MIN_SIZE = sizeof(T) * N;
+        static constexpr bool FIXED = true;
+        static constexpr int LUA_VALUES = 1;
+
+        static bool valid(const Type&) {
+            return true;
+        }
+
+        static size_t size(const Type&) {
+            return MIN_SIZE;
+        }
+
+        static size_t measure(const uint8_t*, size_t available) {
+            return available < MIN_SIZE ? TRUNCATED : MIN_SIZE;
+        }
+
+        static void read(const uint8_t*& in, Type& value) {
+            memcpy(value.data(), in, MIN_SIZE);
+            in += MIN_SIZE;
+        }
+
+        static void write(uint8_t*& out, const Type& value) {
+            memcpy(out, value.data(), MIN_SIZE);
+            out += MIN_SIZE;
+        }
+    };
+
+    // u16 length followed by the bytes, same as NetworkMessage::addString
+    struct String
+    {
+        using Type = std::string_view;
+        static constexpr size_t MIN_SIZE = sizeof(uint16_t);
+        static constexpr bool FIXED = false;
+        static constexpr int LUA_VALUES = 1;
+        static constexpr size_t MAX_LENGTH = 8192;
+
+        static bool valid(const Type& value) {
+            return value.size() <= MAX_LENGTH;
+        }
+
+        static size_t size(const Type& value) {
+            return sizeof(uint16_t) + value.size();
+        }
+
+        static size_t measure(const uint8_t* in, size_t available) {
+            if (available < sizeof(uint16_t)) {
+                return TRUNCATED;
+            }
+
+            uint16_t length;
+            memcpy(&length, in, sizeof(uint16_t));
+            if (sizeof(uint16_t) + length > available) {
+                return TRUNCATED;
+            }
+            return sizeof(uint16_t) + length;
+        }
+
+        static void read(const uint8_t*& in, Type& value) {
+            uint16_t length;
+            memcpy(&length, in, sizeof(uint16_t));
+            value = Type(reinterpret_cast<const char*>(in + sizeof(uint16_t)), length);
+            in += sizeof(uint16_t) + length;
+        }
+
+        static void write(uint8_t*& out, const Type& value) {
+            uint16_t length = static_cast<uint16_t>(value.size());
+            memcpy(out, &length, sizeof(uint16_t));
+            memcpy(out + sizeof(uint16_t), value.data(), length);
+            out += sizeof(uint16_t) + length;
+        }
+    };
+
+    struct Padding {};
+
+    // ignored on read, zero filled on write
+    template<size_t N>
+    struct Skip
+    {
+        using Type = Padding;
+        static constexpr size_t MIN_SIZE = N;
+        static constexpr bool FIXED = true;
+        static constexpr int LUA_VALUES = 0;
+
+        static bool valid(const Type&) {
+            return true;
+        }
+
+        static size_t size(const Type&) {
+            return N;
+        }
+
+        static size_t measure(const uint8_t*, size_t available) {
+            return available < N ? TRUNCATED : N;
+        }
+
+        static void read(const uint8_t*& in, Type&) {
+            in += N;
+        }
+
+        static void write(uint8_t*& out, const Type&) {
+            memset(out, 0, N);
+            out += N;
+        }
+    };
+
+    template<typename... Fields>
+    struct Schema
+    {
+        using Values = std::tuple<typename Fields::Type...>;
+        using Type = Values;
+
+        static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+        static constexpr size_t MIN_SIZE = (Fields::MIN_SIZE + ... + 0);
+        static constexpr bool FIXED = (Fields::FIXED && ...);
+        static constexpr int LUA_VALUES = (Fields::LUA_VALUES + ... + 0);
+
+        static bool valid(const Values& values) {
+            return std::apply([](const auto&... value) { return (Fields::valid(value) && ...); }, values);
+        }
+
+        static size_t size(const Values& values) {
+            return std::apply([](const auto&... value) { return (Fields::size(value) + ... + 0); }, values);
+        }
+
+        static size_t measure(const uint8_t* in, size_t available) {
+            if constexpr (FIXED) {
+                return available < MIN_SIZE ? TRUNCATED : MIN_SIZE;
+            } else {
+                size_t total = 0;
+                if (!(measureField<Fields>(in, available, total) && ...)) {
+                    return TRUNCATED;
+                }
+                return total;
+            }
+        }
+
+        static void read(const uint8_t*& in, Values& values) {
+            std::apply([&in](auto&... value) { (Fields::read(in, value), ...); }, values);
+        }
+
+        static void write(uint8_t*& out, const Values& values) {
+            std::apply([&out](const auto&... value) { (Fields::write(out, value), ...); }, values);
+        }
+
+        // calls func(Field{}, value) for every field in wire order
+        template<typename Values_, typename Func>
+        static void forEach(Values_& values, Func&& func) {
+            std::apply([&func](auto&... value) { (func(Fields{}, value), ...); }, values);
+        }
+
+        static bool decode(NetworkMessage& msg, Values& values) {
+            const uint8_t* in = msg.readBytes(measure(msg.getReadCursor(), msg.getReadableBytes()));
+            if (!in) {
+                return false;
+            }
+
+            read(in, values);
+            return true;
+        }
+
+        static bool encode(NetworkMessage& msg, const Values& values) {
+            if (!valid(values)) {
+                return false;
+            }
+
+            uint8_t* out = msg.reserveBytes(size(values));
+            if (!out) {
+                return false;
+            }
+
+            write(out, values);
+            return true;
+        }
+
+    private:
+        template<typename Field>
+        static bool measureField(const uint8_t*& in, size_t& available, size_t& total) {
+            size_t fieldSize = Field::measure(in, available);
+            if (fieldSize == TRUNCATED) {
+                return false;
+            }
+
+            in += fieldSize;
+            available -= fieldSize;
+            total += fieldSize;
+            return true;
+        }
+    };
+
+    // count prefixed sequence of records, Record is a Schema
+    template<typename Count, typename Record>
+    struct List
+    {
+        using Type = std::vector<typename Record::Values>;
+        static constexpr size_t MIN_SIZE = sizeof(Count);
+        static constexpr bool FIXED = false;
+        static constexpr int LUA_VALUES = 1;
+
+        // entries past the counter range are not sent
+        static size_t count(const Type& value) {
+            return std::min<size_t>(value.size(), std::numeric_limits<Count>::max());
+        }
+
+        static bool valid(const Type& value) {
+            for (size_t i = 0, n = count(value); i < n; ++i) {
+                if (!Record::valid(value[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static size_t size(const Type& value) {
+            size_t total = sizeof(Count);
+            for (size_t i = 0, n = count(value); i < n; ++i) {
+                total += Record::size(value[i]);
+            }
+            return total;
+        }
+
+        static size_t measure(const uint8_t* in, size_t available) {
+            if (available < sizeof(Count)) {
+                return TRUNCATED;
+            }
+
+            Count n;
+            memcpy(&n, in, sizeof(Count));
+
+            size_t total = sizeof(Count);
+            for (Count i = 0; i < n; ++i) {
+                size_t recordSize = Record::measure(in + total, available - total);
+                if (recordSize == TRUNCATED) {
+                    return TRUNCATED;
+                }
+                total += recordSize;
+            }
+            return total;
+        }
+
+        static void read(const uint8_t*& in, Type& value) {
+            Count n;
+            memcpy(&n, in, sizeof(Count));
+            in += sizeof(Count);
+
+            value.resize(n);
+            for (auto& record : value) {
+                Record::read(in, record);
+            }
+        }
+
+        static void write(uint8_t*& out, const Type& value) {
+            Count n = static_cast<Count>(count(value));
+            memcpy(out, &n, sizeof(Count));
+            out += sizeof(Count);
+
+            for (Count i = 0; i < n; ++i) {
+                Record::write(out, value[i]);
+            }
+        }
+    };
+
+    /**
+     * Schema of an opcode packet. Encoding writes the opcode in front of the
+     * fields, decoding reads the fields only since the opcode was already
+     * consumed to dispatch the packet (Protocol::parsePacket).
+     */
+    template<uint8_t Opcode, typename... Fields>
+    struct Message : Schema<Fields...>
+    {
+        using Base = Schema<Fields...>;
+        using typename Base::Values;
+
+        static constexpr uint8_t OPCODE = Opcode;
+
+        static size_t size(const Values& values) {
+            return 1 + Base::size(values);
+        }
+
+        static bool encode(NetworkMessage& msg, const Values& values) {
+            if (!Base::valid(values)) {
+                return false;
+            }
+
+            uint8_t* out = msg.reserveBytes(size(values));
+            if (!out) {
+                return false;
+            }
+
+            *out++ = OPCODE;
+            Base::write(out, values);
+            return true;
+        }
+    };
+}
+
+#endif
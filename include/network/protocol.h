@@ -12,7 +12,8 @@ static constexpr auto AUTHENTICATOR_PERIOD = 30U;
 
 #include <utils/types.h>
 #include <network/connection.h>
-#include <database/database.h>
+#include <database/accountstore.h>
+#include <network/characterlistcache.h>
 
 enum Opcode {
     Authenticate = 1,
@@ -22,6 +23,8 @@ enum Opcode {
     SessionKey = 5,
     Ping = 6,
     LoadingMessage = 7,
+    // custom opcodes (lib/const.lua)
+    GameServerHost = 8,
 };
 
 class Protocol : public std::enable_shared_from_this<Protocol>
@@ -57,7 +60,9 @@ class Protocol : public std::enable_shared_from_this<Protocol>
     private:
         void addMOTD(OutputMessage& msg);
         void addSessionKey(OutputMessage& msg);
-        void addCharacterList(OutputMessage& msg);
+        void addCharacterList(OutputMessage& msg, const std::string& characters);
+        // dbRows: characters returned by the AccountStore, 0 on a cache hit
+        CharacterListCache::Payload loadCharacterList(uint32_t& dbRows);
         void disconnect() const {
             if (auto m_connection = getConnection()) {
                 m_connection->close();
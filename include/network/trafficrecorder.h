@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef NETWORK_TRAFFICRECORDER_H
+#define NETWORK_TRAFFICRECORDER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+/**
+ * Writes the decrypted client traffic to a file for tools/replay.
+ *
+ *   file:    "PWOR", u8 format version
+ *   record:  u8 type, varint connection id, varint us since the previous
+ *            record, varint size, size bytes
+ *   Login:   u16 client version, 4 x u32 XTEA key, u16 length + email
+ *            (the password is never written)
+ *   Packet:  XTEA payload, opcode first
+ *   Close:   empty
+ *
+ * Integers are little endian, varints LEB128. Nothing is written while not
+ * recording apart from one relaxed load per frame.
+ */
+class TrafficRecorder
+{
+    public:
+        static constexpr uint8_t FORMAT_VERSION = 1;
+
+        enum RecordType : uint8_t {
+            Login = 1,
+            Packet = 2,
+            Close = 3,
+        };
+
+        TrafficRecorder() = default;
+
+        // non-copyable
+        TrafficRecorder(const TrafficRecorder&) = delete;
+        TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+        // new recording-<unix time>.bin in directory, false when it is already recording or the file can not be created
+        bool start(const std::string& directory);
+        void stop();
+
+        bool isRecording() const {
+            return m_recording.load(std::memory_order_relaxed);
+        }
+
+        // path and records of the running or last recording
+        std::string getStatus();
+
+        void recordLogin(uint64_t connectionId, uint16_t version, const std::array<uint32_t, 4>& key, std::string_view email);
+        void recordPacket(uint64_t connectionId, const uint8_t* data, size_t size);
+        void recordClose(uint64_t connectionId);
+
+    private:
+        void write(RecordType type, uint64_t connectionId, const uint8_t* data, size_t size);
+
+        std::atomic<bool> m_recording{false};
+
+        std::mutex m_mutex;
+        std::ofstream m_file;
+        std::string m_path;
+        uint64_t m_records = 0;
+        std::chrono::steady_clock::time_point m_last;
+};
+
+extern TrafficRecorder g_trafficRecorder;
+
+#endif
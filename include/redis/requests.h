@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef REDIS_REQUESTS_H
+#define REDIS_REQUESTS_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+#include <utils/tools.h>
+
+/**
+ * Request/answer correlation over redis pub/sub.
+ *
+ * A request is published with "__answer": true and a "__answerId", the
+ * answer comes back on the subscribed channel carrying the same id. Ids are
+ * shared with the Lua side (g_redis.nextRequestId, lib/login.lua) so answers
+ * to requests registered here never reach the onRedisMessage handlers.
+ *
+ * Callbacks run on the dispatcher thread, once: with the answer or, after
+ * the timeout, with timedOut set.
+ */
+class RedisRequests
+{
+    public:
+        struct Answer {
+            bool timedOut = false;
+            std::string message;
+            JsonFields fields;
+        };
+
+        using Callback = std::function<void(const Answer&)>;
+
+        RedisRequests() = default;
+
+        // non-copyable
+        RedisRequests(const RedisRequests&) = delete;
+        RedisRequests& operator=(const RedisRequests&) = delete;
+
+        void setTimeout(uint32_t ms) {
+            m_timeout = ms;
+        }
+
+        uint64_t nextId() {
+            return ++m_idGenerator;
+        }
+
+        // publishes the string fields as a JSON object with a new answer id
+        bool request(const std::string& channel, const std::vector<std::pair<std::string, std::string>>& fields, Callback callback, uint32_t timeout = 0);
+
+        // publishes a payload already carrying answerId (Lua g_redis.request)
+        bool send(uint64_t answerId, const std::string& channel, const std::string& payload, Callback callback, uint32_t timeout = 0);
+
+        // called by the subscriber thread, false when the message is not an answer to a registered request
+        bool dispatchAnswer(const std::string& message);
+
+    private:
+        void expire(uint64_t answerId);
+
+        struct PendingRequest {
+            Callback callback;
+            uint32_t timeoutEvent;
+        };
+
+        std::atomic<uint64_t> m_idGenerator{0};
+        uint32_t m_timeout = 30000;
+
+        std::mutex m_mutex;
+        std::unordered_map<uint64_t, PendingRequest> m_pending;
+};
+
+extern RedisRequests g_redisRequests;
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef SCRIPT_BYTECODECACHE_H
+#define SCRIPT_BYTECODECACHE_H
+
+#include <filesystem>
+#include <string>
+
+struct lua_State;
+
+/**
+ * On-disk cache of compiled Lua chunks (lua_dump / string.dump format).
+ *
+ * Every source file gets one cache file holding the source mtime, size and
+ * hash, the LuaJIT version and the bytecode. A cache file is only used while
+ * all of them still match, otherwise the source is compiled again and the
+ * cache file rewritten, so edited scripts never need a manual flush.
+ *
+ * Bytecode is not verified by LuaJIT, the cache directory must only be
+ * writable by the server.
+ */
+class BytecodeCache
+{
+    public:
+        BytecodeCache() = default;
+
+        // non-copyable
+        BytecodeCache(const BytecodeCache&) = delete;
+        BytecodeCache& operator=(const BytecodeCache&) = delete;
+
+        // empty directory disables the cache
+        bool setDirectory(const std::string& directory);
+        bool isEnabled() const {
+            return !m_directory.empty();
+        }
+
+        // same contract as luaL_loadfile: pushes the chunk or the error message
+        int load(lua_State* L, const std::string& file);
+
+        uint64_t getHits() const {
+            return m_hits;
+        }
+        uint64_t getMisses() const {
+            return m_misses;
+        }
+
+    private:
+        struct Header {
+            char magic[8];
+            int64_t mtime;
+            uint64_t size;
+            uint64_t hash;
+            char version[32];
+        };
+
+        std::filesystem::path getCachePath(const std::string& file) const;
+        void store(lua_State* L, const std::filesystem::path& cachePath, const Header& header);
+
+        std::filesystem::path m_directory;
+
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+};
+
+#endif
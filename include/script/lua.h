@@ -10,6 +10,7 @@
 
 #include <fmt/format.h>
 #include <functional>
+#include <mutex>
 #include <cassert>
 
 #if __has_include("luajit/lua.hpp")
@@ -25,6 +26,11 @@
 #include <network/networkmessage.h>
 #include <network/outputmessage.h>
 
+#include <script/luaallocator.h>
+#include <script/bytecodecache.h>
+#include <script/luaprofiler.h>
+#include <script/luawatchdog.h>
+
 #include <utils/types.h>
 
 class Module;
@@ -184,6 +190,20 @@ class LuaScript
 
 		// Global functions
 		static int32_t luaEmit(lua_State* L);
+		static int32_t luaSpawn(lua_State* L);
+		static int32_t luaMemoryStats(lua_State* L);
+		static int32_t luaGcStats(lua_State* L);
+		static int32_t luaDofile(lua_State* L);
+
+		// g_logger
+		static int32_t luaLoggerInfo(lua_State* L);
+		static int32_t luaLoggerWarning(lua_State* L);
+		static int32_t luaLoggerError(lua_State* L);
+
+		// g_profiler
+		static int32_t luaProfilerStart(lua_State* L);
+		static int32_t luaProfilerStop(lua_State* L);
+		static int32_t luaProfilerDump(lua_State* L);
 
 		// g_login
 		static int32_t luaLoginGetClient(lua_State* L);
@@ -191,6 +211,12 @@ class LuaScript
 		// g_redis
 		static int32_t luaRedisPublish(lua_State* L);
 		static int32_t luaRedisSubscribe(lua_State* L);
+		static int32_t luaRedisNextRequestId(lua_State* L);
+		static int32_t luaRedisAwaitAnswer(lua_State* L);
+
+		// db
+		static int32_t luaDatabaseQuery(lua_State* L);
+		static int32_t luaDatabaseEscapeString(lua_State* L);
 
 		// Module
 		static int32_t luaModuleConnect(lua_State* L);
@@ -214,6 +240,9 @@ class LuaScript
 		static int32_t luaNetworkMessageAddU64(lua_State* L);
 		static int32_t luaNetworkMessageAddString(lua_State* L);
 
+		static int32_t luaNetworkMessageRead(lua_State* L);
+		static int32_t luaNetworkMessageWrite(lua_State* L);
+
 		// OutputMessage
 		static int32_t luaOutputMessageCreate(lua_State* L);
 		static int32_t luaOutputMessageDelete(lua_State* L);
@@ -475,6 +504,11 @@ class LuaScript
 			return lua_isuserdata(L, arg) != 0;
 		}
 
+		// userdata pushed with the metatable of className (setMetatable)
+		static bool isUserdataOf(lua_State* L, int32_t arg, const char* className);
+		// nullptr unless arg is a NetworkMessage or an OutputMessage
+		static NetworkMessage* getNetworkMessage(lua_State* L, int32_t arg);
+
         static bool isString(lua_State* L, int32_t arg) {
 			return lua_isstring(L, arg) != 0;
 		}
@@ -555,8 +589,10 @@ class LuaScript
 		static void pushBoolean(lua_State* L, bool value);
 		static void pushNil(lua_State* L);
 
-        static void pushString(lua_State* L, const std::string& value);
+        static void pushString(lua_State* L, std::string_view value);
         static std::string getString(lua_State* L, int32_t arg);
+        // no copy, only valid while the value stays on the stack
+        static std::string_view getStringView(lua_State* L, int32_t arg);
         static std::string popString(lua_State* L);
 
         const std::string& getLastLuaError() const {
@@ -569,6 +605,39 @@ class LuaScript
 
         lua_State* getLuaState() { return m_luaState; }
 
+		// the io thread (packets) and the dispatcher (tasks, reloads, coroutine
+		// resumes) both run Lua, every entry point into the state holds this
+		std::recursive_mutex& getMutex() { return m_mutex; }
+
+		BytecodeCache& getBytecodeCache() { return m_bytecodeCache; }
+		LuaProfiler& getProfiler() { return m_profiler; }
+		LuaWatchdog& getWatchdog() { return m_watchdog; }
+		LuaAllocator& getAllocator() { return m_allocator; }
+		// false when the state runs on the LuaJIT allocator (x64 without GC64)
+		bool hasAllocatorAccounting() const { return m_allocatorAccounting; }
+
+		// coroutines started by spawn(), resumed from C++ once the awaited
+		// redis answer or database result arrives
+		bool isCoroutine(lua_State* L) const {
+			return m_coroutines.find(L) != m_coroutines.end();
+		}
+		void resumeCoroutine(lua_State* co, int nargs);
+
+		struct GcStats {
+			uint64_t cycles = 0;
+			// idle steps and time spent in them by the last finished cycle
+			uint32_t lastCycleSteps = 0;
+			double lastCycleTime = 0;
+			double totalTime = 0;
+			// KB in use after the last finished cycle
+			int32_t liveSize = 0;
+		};
+
+		// one incremental collection step, called by the dispatcher while
+		// idle; returns true while the current cycle is not finished
+		bool stepGarbageCollector();
+		const GcStats& getGcStats() const { return m_gcStats; }
+
     private:
         static std::string getStackTrace(lua_State* L, const std::string& error_desc);
 
@@ -578,6 +647,30 @@ class LuaScript
         std::string m_loadingFile;
 
         lua_State* m_luaState = nullptr;
+		std::recursive_mutex m_mutex;
+
+		struct Coroutine {
+			// registry reference keeping it alive while suspended
+			int32_t ref;
+			// module (LuaAllocator owner) that spawned it
+			uint16_t owner;
+		};
+		std::unordered_map<lua_State*, Coroutine> m_coroutines;
+
+		// member, so it is only destroyed after ~LuaScript closed the state
+		LuaAllocator m_allocator;
+		bool m_allocatorAccounting = false;
+
+		BytecodeCache m_bytecodeCache;
+		LuaProfiler m_profiler;
+		LuaWatchdog m_watchdog;
+
+		GcStats m_gcStats;
+		bool m_gcCycleRunning = false;
+		uint32_t m_gcCycleSteps = 0;
+		double m_gcCycleTime = 0;
+		int32_t m_gcStepSize = 0;
+		int32_t m_gcIdleThreshold = 0;
 };
 
 extern LuaScriptPtr g_lua;
@@ -856,7 +949,7 @@ template<>
 struct LuaStack::Pop<NetworkMessage>
 {
 	static NetworkMessage* Value(lua_State* L, int index = -1) {
-		NetworkMessage* value = LuaScript::getUserdata<NetworkMessage>(L, index);
+		NetworkMessage* value = LuaScript::getNetworkMessage(L, index);
 		lua_pop(L, 1);
 		return value;
 	}
@@ -875,7 +968,10 @@ template<>
 struct LuaStack::Pop<OutputMessage>
 {
 	static OutputMessage* Value(lua_State* L, int index = -1) {
-		OutputMessage* value = LuaScript::getUserdata<OutputMessage>(L, index);
+		OutputMessage* value = nullptr;
+		if (LuaScript::isUserdataOf(L, index, "OutputMessage")) {
+			value = LuaScript::getUserdata<OutputMessage>(L, index);
+		}
 		lua_pop(L, 1);
 		return value;
 	}
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef SCRIPT_LUAALLOCATOR_H
+#define SCRIPT_LUAALLOCATOR_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * lua_Alloc of the Lua state.
+ *
+ * Blocks up to MAX_POOLED_SIZE come from size-class pools that are never
+ * returned to the system, larger ones from malloc. Every block starts with
+ * an 8 byte header naming the owner (module) it was allocated for, so the
+ * bytes go back to the same owner when freed, whoever is running then.
+ *
+ * The owner of new allocations is the module currently executing, set by
+ * OwnerScope around module loading, event callbacks and coroutine resumes.
+ * Modules above the soft limit are reported once, allocations that would
+ * take a module above the hard limit fail with a Lua memory error.
+ */
+class LuaAllocator
+{
+    public:
+        // config.lua, lib/*.lua and the bindings
+        static constexpr uint16_t CORE_OWNER = 0;
+
+        struct OwnerStats {
+            std::string name;
+            int64_t bytes = 0;
+            int64_t peak = 0;
+            uint64_t allocations = 0;
+            uint64_t failures = 0;
+            bool overSoftLimit = false;
+        };
+
+        class OwnerScope
+        {
+            public:
+                OwnerScope(LuaAllocator& allocator, uint16_t owner) : m_allocator(allocator), m_previous(allocator.m_currentOwner) {
+                    allocator.m_currentOwner = owner;
+                }
+
+                ~OwnerScope() {
+                    m_allocator.m_currentOwner = m_previous;
+                }
+
+                // non-copyable
+                OwnerScope(const OwnerScope&) = delete;
+                OwnerScope& operator=(const OwnerScope&) = delete;
+
+            private:
+                LuaAllocator& m_allocator;
+                uint16_t m_previous;
+        };
+
+        LuaAllocator();
+        ~LuaAllocator();
+
+        // non-copyable
+        LuaAllocator(const LuaAllocator&) = delete;
+        LuaAllocator& operator=(const LuaAllocator&) = delete;
+
+        static void* alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+        uint16_t registerOwner(const std::string& name);
+        uint16_t getCurrentOwner() const {
+            return m_currentOwner;
+        }
+
+        // bytes per module, 0 disables the limit
+        void setLimits(size_t softLimit, size_t hardLimit) {
+            m_softLimit = softLimit;
+            m_hardLimit = hardLimit;
+        }
+
+        const OwnerStats& getOwnerStats(uint16_t owner) const {
+            return m_owners[owner];
+        }
+        const std::vector<OwnerStats>& getStats() const {
+            return m_owners;
+        }
+
+        // memory held by the pools, used or not
+        size_t getPoolBytes() const {
+            return m_slabs.size() * SLAB_SIZE;
+        }
+
+    private:
+        static constexpr size_t HEADER_SIZE = 8;
+        static constexpr size_t SLAB_SIZE = 64 * 1024;
+        static constexpr std::array<size_t, 8> SIZE_CLASSES = {16, 32, 48, 64, 96, 128, 192, 256};
+        static constexpr size_t MAX_POOLED_SIZE = SIZE_CLASSES.back() - HEADER_SIZE;
+        static constexpr uint8_t UNPOOLED = 0xFF;
+
+        struct BlockHeader {
+            uint16_t owner;
+            uint8_t sizeClass;
+            uint8_t reserved[5];
+        };
+        static_assert(sizeof(BlockHeader) == HEADER_SIZE, "block header has to keep the 8 byte alignment");
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        static uint8_t getSizeClass(size_t size);
+
+        void* allocate(uint16_t owner, size_t size);
+        void* reallocate(void* ptr, size_t osize, size_t nsize);
+        void release(void* ptr, size_t size);
+
+        BlockHeader* allocateBlock(uint8_t sizeClass, size_t size);
+        void releaseBlock(BlockHeader* header);
+
+        bool canGrow(uint16_t owner, size_t size);
+        void account(uint16_t owner, int64_t size);
+
+        std::array<FreeBlock*, SIZE_CLASSES.size()> m_freeLists{};
+        std::vector<void*> m_slabs;
+
+        std::vector<OwnerStats> m_owners;
+        uint16_t m_currentOwner = CORE_OWNER;
+
+        size_t m_softLimit = 0;
+        size_t m_hardLimit = 0;
+};
+
+#endif
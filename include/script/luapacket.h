@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef SCRIPT_LUAPACKET_H
+#define SCRIPT_LUAPACKET_H
+
+#include <script/lua.h>
+#include <network/packetschema.h>
+
+#include <iterator>
+
+/**
+ * Lua bindings generated from the packet schemas (network/packets.h).
+ *
+ *   Packet.<Name>.decode(msg)        -> values in field order, nil when truncated
+ *   Packet.<Name>.encode(msg, ...)   -> true when the packet was written
+ *   Packet.<Name>.size(...)          -> encoded size in bytes
+ *   Packet.<Name>.fields             -> field names in value order
+ *   Packet.<Name>.opcode             -> opcode of Message schemas
+ *
+ * Skip fields take no Lua value, lists are arrays of tables keyed by the
+ * record field names.
+ */
+namespace LuaPacket
+{
+	// records (schemas nested in a List), pushed as tables keyed by Record::FIELDS
+	template<typename Record>
+	struct Value
+	{
+		static void push(lua_State* L, const typename Record::Values& values) {
+			lua_createtable(L, 0, Record::LUA_VALUES);
+			size_t index = 0;
+			Record::forEach(values, [L, &index](auto field, const auto& value) {
+				using Field = decltype(field);
+				const char* name = Record::FIELDS[index++];
+				if constexpr (Field::LUA_VALUES != 0) {
+					Value<Field>::push(L, value);
+					lua_setfield(L, -2, name);
+				}
+			});
+		}
+
+		static void get(lua_State* L, int32_t arg, typename Record::Values& values) {
+			size_t index = 0;
+			Record::forEach(values, [L, arg, &index](auto field, auto& value) {
+				using Field = decltype(field);
+				const char* name = Record::FIELDS[index++];
+				if constexpr (Field::LUA_VALUES != 0) {
+					lua_getfield(L, arg, name);
+					Value<Field>::get(L, lua_gettop(L), value);
+					// strings stay referenced by the record table
+					lua_pop(L, 1);
+				}
+			});
+		}
+	};
+
+	template<typename T>
+	struct Value<PacketSchema::Number<T>>
+	{
+		static void push(lua_State* L, T value) {
+			lua_pushnumber(L, static_cast<lua_Number>(value));
+		}
+
+		static void get(lua_State* L, int32_t arg, T& value) {
+			value = static_cast<T>(lua_tonumber(L, arg));
+		}
+	};
+
+	template<typename T, size_t N>
+	struct Value<PacketSchema::Array<T, N>>
+	{
+		static void push(lua_State* L, const std::array<T, N>& value) {
+			lua_createtable(L, N, 0);
+			for (size_t i = 0; i < N; ++i) {
+				lua_pushnumber(L, static_cast<lua_Number>(value[i]));
+				lua_rawseti(L, -2, i + 1);
+			}
+		}
+
+		static void get(lua_State* L, int32_t arg, std::array<T, N>& value) {
+			value = {};
+			if (!lua_istable(L, arg)) {
+				return;
+			}
+
+			for (size_t i = 0; i < N; ++i) {
+				lua_rawgeti(L, arg, i + 1);
+				value[i] = static_cast<T>(lua_tonumber(L, -1));
+				lua_pop(L, 1);
+			}
+		}
+	};
+
+	template<>
+	struct Value<PacketSchema::String>
+	{
+		static void push(lua_State* L, std::string_view value) {
+			lua_pushlstring(L, value.data(), value.size());
+		}
+
+		// the view points into the Lua string, valid while it stays on the stack
+		static void get(lua_State* L, int32_t arg, std::string_view& value) {
+			size_t length = 0;
+			const char* data = lua_tolstring(L, arg, &length);
+			value = data ? std::string_view(data, length) : std::string_view();
+		}
+	};
+
+	template<size_t N>
+	struct Value<PacketSchema::Skip<N>>
+	{
+		static void push(lua_State*, PacketSchema::Padding) {}
+		static void get(lua_State*, int32_t, PacketSchema::Padding&) {}
+	};
+
+	template<typename Count, typename Record>
+	struct Value<PacketSchema::List<Count, Record>>
+	{
+		using Type = typename PacketSchema::List<Count, Record>::Type;
+
+		static void push(lua_State* L, const Type& value) {
+			lua_createtable(L, value.size(), 0);
+			for (size_t i = 0; i < value.size(); ++i) {
+				Value<Record>::push(L, value[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+		}
+
+		static void get(lua_State* L, int32_t arg, Type& value) {
+			value.clear();
+			if (!lua_istable(L, arg)) {
+				return;
+			}
+
+			size_t count = lua_objlen(L, arg);
+			value.resize(count);
+			for (size_t i = 0; i < count; ++i) {
+				lua_rawgeti(L, arg, i + 1);
+				if (lua_istable(L, -1)) {
+					Value<Record>::get(L, lua_gettop(L), value[i]);
+				}
+				lua_pop(L, 1);
+			}
+		}
+	};
+
+	// packet values as consecutive stack values
+	template<typename Packet>
+	void pushValues(lua_State* L, const typename Packet::Values& values)
+	{
+		Packet::forEach(values, [L](auto field, const auto& value) {
+			Value<decltype(field)>::push(L, value);
+		});
+	}
+
+	template<typename Packet>
+	void getValues(lua_State* L, int32_t arg, typename Packet::Values& values)
+	{
+		Packet::forEach(values, [L, &arg](auto field, auto& value) {
+			using Field = decltype(field);
+			Value<Field>::get(L, arg, value);
+			arg += Field::LUA_VALUES;
+		});
+	}
+
+	template<typename Packet>
+	int32_t luaDecode(lua_State* L)
+	{
+		// Packet.<Name>.decode(msg)
+		NetworkMessage* msg = LuaScript::getNetworkMessage(L, 1);
+		LuaScript::clearStack(L);
+
+		typename Packet::Values values;
+		if (!msg || !Packet::decode(*msg, values)) {
+			lua_pushnil(L);
+			return LuaScript::getTop(L);
+		}
+
+		lua_checkstack(L, Packet::LUA_VALUES);
+		pushValues<Packet>(L, values);
+		return LuaScript::getTop(L);
+	}
+
+	template<typename Packet>
+	int32_t luaEncode(lua_State* L)
+	{
+		// Packet.<Name>.encode(msg, ...)
+		NetworkMessage* msg = LuaScript::getNetworkMessage(L, 1);
+
+		typename Packet::Values values;
+		getValues<Packet>(L, 2, values);
+
+		bool written = msg && Packet::encode(*msg, values);
+		LuaScript::clearStack(L);
+		LuaStack::Push<bool>::Value(L, written);
+		return LuaScript::getTop(L);
+	}
+
+	template<typename Packet>
+	int32_t luaSize(lua_State* L)
+	{
+		// Packet.<Name>.size(...)
+		typename Packet::Values values;
+		getValues<Packet>(L, 1, values);
+
+		size_t size = Packet::size(values);
+		LuaScript::clearStack(L);
+		lua_pushnumber(L, static_cast<lua_Number>(size));
+		return LuaScript::getTop(L);
+	}
+
+	template<typename Packet, typename = void>
+	struct Opcode
+	{
+		static void push(lua_State*) {}
+	};
+
+	template<typename Packet>
+	struct Opcode<Packet, std::void_t<decltype(Packet::OPCODE)>>
+	{
+		static void push(lua_State* L) {
+			lua_pushnumber(L, Packet::OPCODE);
+			lua_setfield(L, -2, "opcode");
+		}
+	};
+
+	// Packet.<name> = {decode, encode, size, fields, opcode}
+	template<typename Packet>
+	void registerPacket(lua_State* L, const char* name)
+	{
+		static_assert(std::size(Packet::FIELDS) == Packet::FIELD_COUNT, "FIELDS has to name every field");
+
+		LuaScript::putGlobalOnStack(L, "Packet");
+		lua_createtable(L, 0, 5);
+
+		lua_pushcfunction(L, luaDecode<Packet>);
+		lua_setfield(L, -2, "decode");
+		lua_pushcfunction(L, luaEncode<Packet>);
+		lua_setfield(L, -2, "encode");
+		lua_pushcfunction(L, luaSize<Packet>);
+		lua_setfield(L, -2, "size");
+
+		lua_createtable(L, Packet::LUA_VALUES, 0);
+		int index = 0;
+		typename Packet::Values values;
+		Packet::forEach(values, [L, &index](auto field, auto&) {
+			const char* fieldName = Packet::FIELDS[index++];
+			if constexpr (decltype(field)::LUA_VALUES != 0) {
+				lua_pushstring(L, fieldName);
+				lua_rawseti(L, -2, static_cast<int>(lua_objlen(L, -2)) + 1);
+			}
+		});
+		lua_setfield(L, -2, "fields");
+
+		Opcode<Packet>::push(L);
+
+		lua_setfield(L, -2, name);
+		LuaScript::pop(L);
+	}
+}
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef SCRIPT_LUAPROFILER_H
+#define SCRIPT_LUAPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+struct lua_State;
+class Module;
+
+/**
+ * Lua profiling mode, off unless started.
+ *
+ * - wall time of every module callback (ModuleManager::emit*), aggregated
+ *   per module, event and identifier into log2 latency histograms
+ * - LuaJIT sampling profiler (jit.profile), aggregated into folded stacks
+ *   that flamegraph.pl / speedscope read directly
+ *
+ * While stopped a callback costs one relaxed atomic load.
+ */
+class LuaProfiler
+{
+    public:
+        // bucket i counts calls below 2^i microseconds, the last one the rest
+        static constexpr size_t BUCKETS = 24;
+
+        struct Histogram {
+            std::array<uint64_t, BUCKETS> buckets{};
+            uint64_t count = 0;
+            uint64_t totalMicros = 0;
+            uint64_t maxMicros = 0;
+
+            void add(uint64_t micros);
+            // upper bound of the bucket holding the given fraction of calls
+            uint64_t percentile(double fraction) const;
+        };
+
+        // (module, event, identifier)
+        using CallKey = std::tuple<std::string, std::string, std::string>;
+
+        class CallTimer
+        {
+            public:
+                CallTimer(LuaProfiler& profiler, Module* module, const std::string& event, const std::string& identifier) :
+                    m_profiler(profiler), m_active(profiler.isEnabled()) {
+                    if (m_active) {
+                        m_module = module;
+                        m_event = &event;
+                        m_identifier = &identifier;
+                        m_start = std::chrono::steady_clock::now();
+                    }
+                }
+
+                ~CallTimer() {
+                    if (m_active) {
+                        m_profiler.recordCall(m_module, *m_event, *m_identifier, std::chrono::steady_clock::now() - m_start);
+                    }
+                }
+
+                // non-copyable
+                CallTimer(const CallTimer&) = delete;
+                CallTimer& operator=(const CallTimer&) = delete;
+
+            private:
+                LuaProfiler& m_profiler;
+                bool m_active;
+                Module* m_module = nullptr;
+                const std::string* m_event = nullptr;
+                const std::string* m_identifier = nullptr;
+                std::chrono::steady_clock::time_point m_start;
+        };
+
+        LuaProfiler() = default;
+
+        // non-copyable
+        LuaProfiler(const LuaProfiler&) = delete;
+        LuaProfiler& operator=(const LuaProfiler&) = delete;
+
+        // sampling interval in milliseconds, 0 only measures the callbacks
+        void start(lua_State* L, uint32_t interval);
+        void stop(lua_State* L);
+        bool isEnabled() const {
+            return m_enabled.load(std::memory_order_relaxed);
+        }
+
+        void recordCall(Module* module, const std::string& event, const std::string& identifier, std::chrono::steady_clock::duration elapsed);
+
+        // writes <directory>/lua-<time>.folded and lua-<time>-latency.txt and
+        // resets the collected data, returns false when nothing was written
+        bool dump(const std::string& directory);
+
+    private:
+        static void sample(void* data, lua_State* L, int samples, int vmstate);
+
+        std::atomic<bool> m_enabled{false};
+        bool m_sampling = false;
+
+        std::mutex m_lock;
+        std::map<CallKey, Histogram> m_calls;
+        std::unordered_map<std::string, uint64_t> m_stacks;
+        uint64_t m_samples = 0;
+};
+
+#endif
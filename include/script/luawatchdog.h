@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef SCRIPT_LUAWATCHDOG_H
+#define SCRIPT_LUAWATCHDOG_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+struct lua_State;
+struct lua_Debug;
+class Module;
+
+/**
+ * Instruction and wall time budget of module callbacks and coroutine
+ * resumes, enforced with a count hook installed for the duration of the
+ * call. A callback over budget is aborted with a Lua error (reported with
+ * its traceback) that keeps being raised until it is out of Lua code, so a
+ * pcall inside the handler can not swallow it.
+ *
+ * Hooks only run in the interpreter, a loop inside a JIT-compiled trace is
+ * caught once it leaves the trace.
+ */
+class LuaWatchdog
+{
+    public:
+        class Scope
+        {
+            public:
+                // module is nullptr for coroutine resumes, owner names them;
+                // event and identifier have to outlive the scope
+                Scope(LuaWatchdog& watchdog, lua_State* L, Module* module, uint16_t owner, const std::string& event, int32_t callback, const std::string& identifier);
+                ~Scope();
+
+                // non-copyable
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                LuaWatchdog& m_watchdog;
+                lua_State* m_L;
+                // false for nested callbacks, the outermost one owns the budget
+                bool m_active = false;
+
+                Module* m_module;
+                uint16_t m_owner;
+                const std::string& m_event;
+                int32_t m_callback;
+                const std::string& m_identifier;
+
+            friend class LuaWatchdog;
+        };
+
+        LuaWatchdog() = default;
+
+        // non-copyable
+        LuaWatchdog(const LuaWatchdog&) = delete;
+        LuaWatchdog& operator=(const LuaWatchdog&) = delete;
+
+        // 0 disables the respective budget, maxViolations the disconnect
+        void setBudget(uint32_t instructions, uint32_t milliseconds, uint32_t hookInterval, uint32_t maxViolations);
+        bool isEnabled() const {
+            return m_instructionBudget != 0 || m_timeBudget.count() != 0;
+        }
+
+        // aborted callbacks per module
+        const std::unordered_map<std::string, uint64_t>& getViolations() const {
+            return m_violations;
+        }
+
+    private:
+        static void hook(lua_State* L, lua_Debug* ar);
+
+        void onViolation(const Scope& scope);
+
+        uint64_t m_instructionBudget = 0;
+        std::chrono::milliseconds m_timeBudget{0};
+        int m_hookInterval = 1000;
+        uint32_t m_maxViolations = 0;
+
+        // state of the running callback
+        bool m_running = false;
+        bool m_exceeded = false;
+        uint64_t m_executed = 0;
+        std::chrono::steady_clock::time_point m_deadline;
+
+        std::unordered_map<std::string, uint64_t> m_violations;
+        std::map<std::pair<Module*, int32_t>, uint32_t> m_callbackViolations;
+};
+
+#endif
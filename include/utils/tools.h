@@ -11,6 +11,7 @@
 #include <random>
 #include <regex>
 #include <any>
+#include <unordered_map>
 
 #include <boost/algorithm/string.hpp>
 
@@ -22,6 +23,18 @@ int64_t OTSYS_TIME();
 
 std::string demangleName(const char* mangledName);
 
+// flat JSON objects exchanged over redis. Strings are unescaped to UTF-8,
+// \u surrogate pairs combined and a lone surrogate becomes U+FFFD; numbers,
+// true, false and null are kept as their text, nested objects and arrays as
+// raw JSON. Input is taken as UTF-8 without validating it or the literals,
+// a repeated key keeps its last value.
+using JsonFields = std::unordered_map<std::string, std::string>;
+bool parseJsonObject(const std::string& json, JsonFields& fields);
+// Lua truthiness of a field: only missing, false and null fail. Strings are
+// unescaped, so the string "false" fails as well.
+bool isJsonTruthy(const JsonFields& fields, const std::string& key);
+std::string escapeJsonString(const std::string& value);
+
 template<typename T>
 T anyCast(std::vector<std::any>& vec, int index, T defaultValue = T())
 {
@@ -13,6 +13,7 @@
 #include <vector>
 #include <any>
 
+class AccountStore;
 class Connection;
 class DBResult;
 class Protocol;
@@ -26,9 +27,11 @@ class RedisSubscriber;
 class NetworkMessage;
 class OutputMessage;
 
+using AccountStorePtr = std::shared_ptr<AccountStore>;
 using ConnectionSharedPtr = std::shared_ptr<Connection>;
 using ConnectionWeakPtr = std::weak_ptr<Connection>;
 using DBResultSharedPtr = std::shared_ptr<DBResult>;
+using DBResultPtr = std::unique_ptr<DBResult>;
 using ProtocolSharedPtr = std::shared_ptr<Protocol>;
 using ServerSharedPtr = std::shared_ptr<Server>;
 using ModuleManagerPtr = std::shared_ptr<ModuleManager>;
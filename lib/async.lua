@@ -0,0 +1,33 @@
+-- Coroutine helpers. spawn (C++) runs a function as a coroutine that may
+-- wait on g_redis.request or db.query; the C++ side resumes it once the
+-- answer, the timeout or the query result arrives.
+
+g_redis = g_redis or {}
+
+-- Runs every call of handler in its own coroutine:
+--   module:connect("onReceiveNetworkMessage", async(handler), ProtocolCode.X)
+-- Packet data has to be read before the first wait, the message is reused
+-- once the handler yields.
+function async(handler)
+  return function(...)
+    spawn(handler, ...)
+  end
+end
+
+-- Publishes data with a new answer id and waits for the answer.
+-- Returns the decoded answer or nil and the reason ("timeout", "publish failed").
+function g_redis.request(channel, data, timeout)
+  local answerId = g_redis.nextRequestId()
+  data.__answer = true
+  data.__answerId = answerId
+
+  local message, err = g_redis.awaitAnswer(channel, json.encode(data), answerId, timeout)
+  if not message then
+    return nil, err
+  end
+
+  local answer = json.decode(message)
+  answer.__answer = nil
+  answer.__answerId = nil
+  return answer
+end
@@ -0,0 +1,142 @@
+-- LuaJIT trace diagnostics, enabled by luaJitDiagnostics = true in config.lua.
+-- Records trace starts, completions and aborts (with the NYI/abort reason)
+-- per source location and reports locations LuaJIT blacklisted, those run
+-- in the interpreter from then on.
+--   jitdiag.report([limit])  logs the locations with the most aborts
+--   jitdiag.stats()          raw data, location -> {started, completed, aborted, reasons, blacklisted}
+
+jitdiag = {}
+
+local locations = {}
+local running = {}
+
+-- jit.* helper modules shipped with LuaJIT, loaded on enable
+local vmdef, jutil, bit
+
+local function fmtfunc(func, pc)
+  local info = jutil.funcinfo(func, pc)
+  if info.loc then
+    return info.loc
+  elseif info.ffid then
+    return vmdef.ffnames[info.ffid]
+  elseif info.addr then
+    return string.format("C:%x", info.addr)
+  end
+  return "?"
+end
+
+-- same formatting as jit.v / jit.dump
+local function fmterr(err, info)
+  if type(err) == "number" then
+    if type(info) == "function" then
+      info = fmtfunc(info)
+    end
+    err = string.format(vmdef.traceerr[err], info)
+  end
+  return err
+end
+
+-- blacklisted bytecodes are patched to their interpreter-only variant
+local BLACKLISTED = {IFORL = true, IITERL = true, ILOOP = true, IFUNCF = true, IFUNCV = true}
+
+local function isBlacklisted(func, pc)
+  local ins = jutil.funcbc(func, pc)
+  if not ins then
+    return false
+  end
+
+  local op = bit.band(ins, 0xff)
+  local name = string.sub(vmdef.bcnames, op * 6 + 1, op * 6 + 6)
+  return BLACKLISTED[string.match(name, "%S+")] == true
+end
+
+local function getLocation(loc)
+  local location = locations[loc]
+  if not location then
+    location = {started = 0, completed = 0, aborted = 0, reasons = {}, blacklisted = false}
+    locations[loc] = location
+  end
+  return location
+end
+
+local function onTrace(what, tr, func, pc, otr, oex)
+  if what == "start" then
+    local loc = fmtfunc(func, pc)
+    local location = getLocation(loc)
+    location.started = location.started + 1
+    running[tr] = {loc = loc, func = func, pc = pc}
+
+  elseif what == "stop" then
+    local trace = running[tr]
+    if trace then
+      local location = getLocation(trace.loc)
+      location.completed = location.completed + 1
+      running[tr] = nil
+    end
+
+  elseif what == "abort" then
+    local trace = running[tr]
+    if trace then
+      running[tr] = nil
+
+      local location = getLocation(trace.loc)
+      location.aborted = location.aborted + 1
+
+      local reason = fmterr(otr, oex) .. " at " .. fmtfunc(func, pc)
+      location.reasons[reason] = (location.reasons[reason] or 0) + 1
+
+      if not location.blacklisted and isBlacklisted(trace.func, trace.pc) then
+        location.blacklisted = true
+        g_logger.warning(string.format("[jitdiag] %s blacklisted after %d aborts, last: %s", trace.loc, location.aborted, reason))
+      end
+    end
+
+  elseif what == "flush" then
+    running = {}
+  end
+end
+
+function jitdiag.stats()
+  return locations
+end
+
+function jitdiag.report(limit)
+  limit = limit or 10
+
+  local sorted = {}
+  for loc, location in pairs(locations) do
+    if location.aborted > 0 then
+      table.insert(sorted, {loc = loc, location = location})
+    end
+  end
+  table.sort(sorted, function(a, b) return a.location.aborted > b.location.aborted end)
+
+  g_logger.info(string.format("[jitdiag] %d locations with trace aborts", #sorted))
+  for i = 1, math.min(limit, #sorted) do
+    local loc, location = sorted[i].loc, sorted[i].location
+
+    local reason, count = nil, 0
+    for r, c in pairs(location.reasons) do
+      if c > count then
+        reason, count = r, c
+      end
+    end
+
+    g_logger.info(string.format("[jitdiag] %s: %d started, %d completed, %d aborted%s, mostly: %s (%d)",
+      loc, location.started, location.completed, location.aborted,
+      location.blacklisted and ", blacklisted" or "", reason, count))
+  end
+end
+
+if luaJitDiagnostics then
+  local ok
+  ok, vmdef = pcall(require, "jit.vmdef")
+  if not ok or not jit or not jit.attach then
+    print("[jitdiag] jit.vmdef not found, trace diagnostics disabled")
+  else
+    jutil = require("jit.util")
+    bit = require("bit")
+    jit.attach(onTrace, "trace")
+    print("[jitdiag] Trace diagnostics enabled")
+  end
+end
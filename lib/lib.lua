@@ -1,4 +1,6 @@
 dofile('lib/const.lua')
 dofile('lib/dump.lua')
 dofile('lib/json.lua')
+dofile('lib/async.lua')
 dofile('lib/login.lua')
+dofile('lib/jitdiag.lua')
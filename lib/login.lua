@@ -1,24 +1,22 @@
 g_login = {
-  answerIdGenerator = 0,
   answerCallbacks = {}
 }
 
 function g_login.requestCentralAnswer(data, callback)
-  g_login.answerIdGenerator = g_login.answerIdGenerator + 1
+  -- ids are shared with the native handlers (RedisRequests)
+  local answerId = g_redis.nextRequestId()
   data.__answer = true
-  data.__answerId = g_login.answerIdGenerator
+  data.__answerId = answerId
 
-  g_login.answerCallbacks[g_login.answerIdGenerator] = callback
+  g_login.answerCallbacks[answerId] = callback
 
   if not g_redis.publish("central_login", json.encode(data)) then
-    g_login.answerCallbacks[g_login.answerIdGenerator] = nil
+    g_login.answerCallbacks[answerId] = nil
   end
 end
 
 function g_login.sendGameServerHost(client, host, port)
   local msg = OutputMessage()
-  msg:addU8(ProtocolCode.GameServerHost)
-  msg:addString(host)
-  msg:addU16(port)
+  Packet.GameServerHost.encode(msg, host, port)
   client:send(msg)
 end
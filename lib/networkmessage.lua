@@ -0,0 +1,307 @@
+-- LuaJIT FFI fast path for NetworkMessage and OutputMessage.
+--
+-- The C API (LuaScript::luaNetworkMessage*) crosses the Lua/C boundary on every
+-- field and can not be compiled by the JIT. Here the same readers and writers
+-- are implemented over a cdef of the NetworkMessage memory layout, so handlers
+-- reading or writing packets stay inside traces.
+--
+-- The C functions are kept in g_messageFFI.capi and stay in use whenever the FFI
+-- is not available or the layout exported by C++ does not match the cdef, and
+-- for arguments that are not a NetworkMessage or an OutputMessage.
+
+g_messageFFI = {
+  enabled = false,
+  capi = {}
+}
+
+local methods = {
+  "getU8", "getU16", "getU32", "getU64", "getString",
+  "addU8", "addU16", "addU32", "addU64", "addString"
+}
+
+for _, name in ipairs(methods) do
+  g_messageFFI.capi[name] = NetworkMessage[name]
+end
+
+local hasFFI, ffi = pcall(require, "ffi")
+if not hasFFI or not jit then
+  print("[NetworkMessage] FFI not available, using the C API")
+  return
+end
+
+local layout = NetworkMessage.layout
+if not layout then
+  print("[NetworkMessage] Layout not exported, using the C API")
+  return
+end
+
+ffi.cdef(string.format([[
+typedef struct {
+  uint16_t length;
+  uint16_t position;
+  bool overrun;
+} pwo_NetworkMessageInfo;
+
+typedef struct {
+  pwo_NetworkMessageInfo info;
+  uint8_t buffer[%d];
+} pwo_NetworkMessage;
+]], layout.maxSize))
+
+if ffi.offsetof("pwo_NetworkMessage", "info") + ffi.offsetof("pwo_NetworkMessageInfo", "length") ~= layout.length
+  or ffi.offsetof("pwo_NetworkMessage", "info") + ffi.offsetof("pwo_NetworkMessageInfo", "position") ~= layout.position
+  or ffi.offsetof("pwo_NetworkMessage", "info") + ffi.offsetof("pwo_NetworkMessageInfo", "overrun") ~= layout.overrun
+  or ffi.offsetof("pwo_NetworkMessage", "buffer") ~= layout.buffer then
+  print("[NetworkMessage] FFI layout mismatch, using the C API")
+  return
+end
+
+local bit = require("bit")
+local band, rshift = bit.band, bit.rshift
+local ffi_cast, ffi_string, ffi_copy = ffi.cast, ffi.string, ffi.copy
+
+local MAXSIZE = layout.maxSize
+local MAX_BODY_LENGTH = layout.maxBodyLength
+local INITIAL_POSITION = layout.initialPosition
+local MAX_STRING_LENGTH = 8192
+
+-- Lua userdata holds a NetworkMessage* (LuaScript::pushUserdata)
+local messagePtrType = ffi.typeof("pwo_NetworkMessage**")
+local capi = g_messageFFI.capi
+
+-- getmetatable returns the class table (__metatable), only userdata of these
+-- two classes hold a NetworkMessage*
+local networkMessageClass, outputMessageClass = NetworkMessage, OutputMessage
+
+-- nil for anything else, the caller passes it on to the C API
+local function toMessage(msg)
+  local class = getmetatable(msg)
+  if class ~= networkMessageClass and class ~= outputMessageClass then
+    return nil
+  end
+
+  local m = ffi_cast(messagePtrType, msg)[0]
+  if m == nil then
+    return nil
+  end
+  return m
+end
+
+-- NetworkMessage::canRead
+local function canRead(m, size)
+  local info = m.info
+  if (info.position + size) > (info.length + 8) or size >= (MAXSIZE - info.position) then
+    info.overrun = true
+    return false
+  end
+  return true
+end
+
+-- NetworkMessage::canAdd
+local function canAdd(m, size)
+  return (size + m.info.position) < MAX_BODY_LENGTH
+end
+
+local function readU16(m)
+  if not canRead(m, 2) then
+    return 0
+  end
+
+  local pos = m.info.position
+  local b = m.buffer
+  m.info.position = pos + 2
+  return b[pos] + b[pos + 1] * 0x100
+end
+
+local function readU32(m)
+  if not canRead(m, 4) then
+    return 0
+  end
+
+  local pos = m.info.position
+  local b = m.buffer
+  m.info.position = pos + 4
+  return b[pos] + b[pos + 1] * 0x100 + b[pos + 2] * 0x10000 + b[pos + 3] * 0x1000000
+end
+
+local function writeBytes(m, value, count)
+  local pos = m.info.position
+  local b = m.buffer
+  for i = 0, count - 1 do
+    b[pos + i] = band(rshift(value, i * 8), 0xFF)
+  end
+  m.info.position = pos + count
+  m.info.length = m.info.length + count
+end
+
+local ffiMethods = {}
+
+function ffiMethods.getU8(msg)
+  -- NetworkMessage:getU8()
+  local m = toMessage(msg)
+  if not m then
+    return capi.getU8(msg)
+  end
+
+  if not canRead(m, 1) then
+    return 0
+  end
+
+  local pos = m.info.position
+  m.info.position = pos + 1
+  return m.buffer[pos]
+end
+
+function ffiMethods.getU16(msg)
+  -- NetworkMessage:getU16()
+  local m = toMessage(msg)
+  if not m then
+    return capi.getU16(msg)
+  end
+  return readU16(m)
+end
+
+function ffiMethods.getU32(msg)
+  -- NetworkMessage:getU32()
+  local m = toMessage(msg)
+  if not m then
+    return capi.getU32(msg)
+  end
+  return readU32(m)
+end
+
+function ffiMethods.getU64(msg)
+  -- NetworkMessage:getU64()
+  local m = toMessage(msg)
+  if not m then
+    return capi.getU64(msg)
+  end
+
+  if not canRead(m, 8) then
+    return 0
+  end
+
+  local low = readU32(m)
+  local high = readU32(m)
+  return low + high * 0x100000000
+end
+
+function ffiMethods.getString(msg)
+  -- NetworkMessage:getString()
+  local m = toMessage(msg)
+  if not m then
+    return capi.getString(msg)
+  end
+
+  local length = readU16(m)
+  if not canRead(m, length) then
+    return ""
+  end
+
+  local pos = m.info.position
+  m.info.position = pos + length
+  return ffi_string(m.buffer + pos, length)
+end
+
+function ffiMethods.addU8(msg, value)
+  -- NetworkMessage:addU8(value)
+  local m = toMessage(msg)
+  if not m then
+    return capi.addU8(msg, value)
+  end
+
+  if canAdd(m, 1) then
+    writeBytes(m, value, 1)
+  end
+  return true
+end
+
+function ffiMethods.addU16(msg, value)
+  -- NetworkMessage:addU16(value)
+  local m = toMessage(msg)
+  if not m then
+    return capi.addU16(msg, value)
+  end
+
+  if canAdd(m, 2) then
+    writeBytes(m, value, 2)
+  end
+  return true
+end
+
+function ffiMethods.addU32(msg, value)
+  -- NetworkMessage:addU32(value)
+  local m = toMessage(msg)
+  if not m then
+    return capi.addU32(msg, value)
+  end
+
+  if canAdd(m, 4) then
+    writeBytes(m, value, 4)
+  end
+  return true
+end
+
+function ffiMethods.addU64(msg, value)
+  -- NetworkMessage:addU64(value)
+  local m = toMessage(msg)
+  if not m then
+    return capi.addU64(msg, value)
+  end
+
+  if canAdd(m, 8) then
+    local high = math.floor(value / 0x100000000)
+    writeBytes(m, value - high * 0x100000000, 4)
+    writeBytes(m, high, 4)
+  end
+  return true
+end
+
+function ffiMethods.addString(msg, value)
+  -- NetworkMessage:addString(value)
+  local m = toMessage(msg)
+  if not m then
+    return capi.addString(msg, value)
+  end
+
+  value = tostring(value)
+  local length = #value
+  if not canAdd(m, length + 2) or length > MAX_STRING_LENGTH then
+    return true
+  end
+
+  writeBytes(m, length, 2)
+
+  local pos = m.info.position
+  ffi_copy(m.buffer + pos, value, length)
+  m.info.position = pos + length
+  m.info.length = m.info.length + length
+  return true
+end
+
+-- Moves the read/write position, used by benchmarks to replay one buffer
+function g_messageFFI.seek(msg, position)
+  local m = toMessage(msg)
+  if m then
+    m.info.position = position or INITIAL_POSITION
+  end
+end
+
+-- Empties the message as NetworkMessage::reset does
+function g_messageFFI.reset(msg)
+  local m = toMessage(msg)
+  if m then
+    m.info.length = 0
+    m.info.position = INITIAL_POSITION
+    m.info.overrun = false
+  end
+end
+
+g_messageFFI.ffi = ffiMethods
+
+-- OutputMessage inherits the NetworkMessage methods through __index
+for _, name in ipairs(methods) do
+  NetworkMessage[name] = ffiMethods[name]
+end
+
+g_messageFFI.enabled = true
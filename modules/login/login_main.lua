@@ -1,36 +1,31 @@
 local _onReceiveNetworkMessage
 
 function init()
-  module:connect("onReceiveNetworkMessage", _onReceiveNetworkMessage, ProtocolCode.GameServerHost)
+  -- GameServerHost is handled natively unless listed in luaOpcodes (config.lua)
+  module:connect("onReceiveNetworkMessage", async(_onReceiveNetworkMessage), ProtocolCode.GameServerHost)
 end
 
 function _onReceiveNetworkMessage(args)
-  local msg = args.msg
-  local client = args.client
-  local clientId = client:getId()
+  local clientId = args.client:getId()
 
-  local instanceName = msg:getString()
-  local instanceId = msg:getString()
+  local instanceName, instanceId = Packet.GameServerHostRequest.decode(args.msg)
+  if not instanceName then
+    return
+  end
 
-  g_login.requestCentralAnswer(
-    {
-      action = "game-server-host",
-      instanceName = instanceName,
-      instanceId = instanceId
-    },
-    function(answer)
-      local client = g_login.getClient(clientId)
-      if not client then
-        return
-      end
+  local answer = g_redis.request("central_login", {
+    action = "game-server-host",
+    instanceName = instanceName,
+    instanceId = instanceId
+  })
+  if not answer or not answer.success then
+    return
+  end
 
-      if not answer.success then
-        return
-      end
+  local client = g_login.getClient(clientId)
+  if not client then
+    return
+  end
 
-      local host = answer.host
-      local port = answer.port
-      g_login.sendGameServerHost(client, host, port)
-    end
-  )
+  g_login.sendGameServerHost(client, answer.host, answer.port)
 end
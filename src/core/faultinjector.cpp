@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <random>
+
+#include <boost/algorithm/string.hpp>
+#include <fmt/format.h>
+
+#include <core/faultinjector.h>
+
+FaultInjector g_faultInjector;
+
+namespace
+{
+    const char* TARGET_NAMES[] = {"database", "redisPublish", "redisDelivery"};
+    const char* DISTRIBUTION_NAMES[] = {"fixed", "uniform", "exponential"};
+
+    std::mt19937_64& getRandom()
+    {
+        thread_local std::mt19937_64 random{std::random_device{}()};
+        return random;
+    }
+
+    bool parseRate(const std::string& value, double& rate)
+    {
+        size_t end = 0;
+        rate = std::stod(value, &end);
+        return end == value.size() && rate >= 0 && rate <= 1;
+    }
+}
+
+bool FaultInjector::parseProfile(const std::string& spec, Profile& profile, std::string& error)
+{
+    Profile parsed = profile;
+
+    std::vector<std::string> fields;
+    boost::split(fields, spec, boost::is_any_of(","), boost::token_compress_on);
+    for (std::string& field : fields) {
+        boost::trim(field);
+        if (field.empty()) {
+            continue;
+        }
+
+        const size_t separator = field.find('=');
+        if (separator == std::string::npos) {
+            error = "missing value for " + field;
+            return false;
+        }
+
+        const std::string key = field.substr(0, separator);
+        const std::string value = field.substr(separator + 1);
+        try {
+            if (key == "latency") {
+                parsed.latency = static_cast<uint32_t>(std::stoul(value));
+            } else if (key == "stall") {
+                parsed.stall = static_cast<uint32_t>(std::stoul(value));
+            } else if (key == "errors" || key == "stalls") {
+                double rate;
+                if (!parseRate(value, rate)) {
+                    error = key + " has to be between 0 and 1";
+                    return false;
+                }
+                (key == "errors" ? parsed.errorRate : parsed.stallRate) = rate;
+            } else if (key == "distribution") {
+                auto it = std::find(std::begin(DISTRIBUTION_NAMES), std::end(DISTRIBUTION_NAMES), value);
+                if (it == std::end(DISTRIBUTION_NAMES)) {
+                    error = "unknown distribution " + value;
+                    return false;
+                }
+                parsed.distribution = static_cast<Distribution>(it - std::begin(DISTRIBUTION_NAMES));
+            } else {
+                error = "unknown key " + key;
+                return false;
+            }
+        } catch (const std::logic_error&) {
+            error = "invalid number for " + key;
+            return false;
+        }
+    }
+
+    profile = parsed;
+    return true;
+}
+
+bool FaultInjector::parseTarget(const std::string& name, FaultTarget& target)
+{
+    for (size_t i = 0; i < TARGETS; ++i) {
+        if (name == TARGET_NAMES[i]) {
+            target = static_cast<FaultTarget>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* FaultInjector::getTargetName(FaultTarget target)
+{
+    return TARGET_NAMES[static_cast<size_t>(target)];
+}
+
+void FaultInjector::setProfile(FaultTarget target, const Profile& profile)
+{
+    const size_t index = static_cast<size_t>(target);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_profiles[index] = profile;
+    m_active[index].store(profile.isActive(), std::memory_order_relaxed);
+}
+
+FaultInjector::Profile FaultInjector::getProfile(FaultTarget target)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_profiles[static_cast<size_t>(target)];
+}
+
+uint64_t FaultInjector::getErrors() const
+{
+    uint64_t errors = 0;
+    for (const auto& counter : m_errors) {
+        errors += counter.load(std::memory_order_relaxed);
+    }
+    return errors;
+}
+
+uint64_t FaultInjector::getStalls() const
+{
+    uint64_t stalls = 0;
+    for (const auto& counter : m_stalls) {
+        stalls += counter.load(std::memory_order_relaxed);
+    }
+    return stalls;
+}
+
+std::string FaultInjector::dump()
+{
+    std::string out;
+    for (size_t i = 0; i < TARGETS; ++i) {
+        const Profile profile = getProfile(static_cast<FaultTarget>(i));
+        out += fmt::format("{:s}: latency={:d},distribution={:s},errors={:g},stalls={:g},stall={:d} ({:d} calls, {:d} errors, {:d} stalls)\n",
+            TARGET_NAMES[i], profile.latency, DISTRIBUTION_NAMES[static_cast<size_t>(profile.distribution)], profile.errorRate, profile.stallRate, profile.stall,
+            m_calls[i].load(std::memory_order_relaxed), m_errors[i].load(std::memory_order_relaxed), m_stalls[i].load(std::memory_order_relaxed));
+    }
+    return out;
+}
+
+bool FaultInjector::applyProfile(FaultTarget target)
+{
+    const size_t index = static_cast<size_t>(target);
+    const Profile profile = getProfile(target);
+    m_calls[index].fetch_add(1, std::memory_order_relaxed);
+
+    std::mt19937_64& random = getRandom();
+    std::uniform_real_distribution<double> chance(0, 1);
+
+    double delay = 0;
+    if (profile.latency != 0) {
+        switch (profile.distribution) {
+            case Distribution::Fixed:
+                delay = profile.latency;
+                break;
+            case Distribution::Uniform:
+                delay = std::uniform_real_distribution<double>(0, 2.0 * profile.latency)(random);
+                break;
+            case Distribution::Exponential:
+                delay = std::exponential_distribution<double>(1.0 / profile.latency)(random);
+                break;
+        }
+    }
+
+    if (profile.stallRate > 0 && chance(random) < profile.stallRate) {
+        m_stalls[index].fetch_add(1, std::memory_order_relaxed);
+        delay += profile.stall;
+    }
+
+    if (delay > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(delay * 1000)));
+    }
+
+    if (profile.errorRate > 0 && chance(random) < profile.errorRate) {
+        m_errors[index].fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include <core/flightrecorder.h>
+#include <core/logger.h>
+#include <core/tasks.h>
+
+FlightRecorder g_flightRecorder;
+
+namespace
+{
+    const char* STAGE_NAMES[] = {"decode", "rsa", "db", "build", "send"};
+    const char* RESULT_NAMES[] = {"ok", "failed", "rejected"};
+
+    uint32_t toMicros(std::chrono::steady_clock::duration duration)
+    {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    // Connection::getIP keeps the address in network byte order
+    std::string formatIp(uint32_t ip)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&ip);
+        return fmt::format("{:d}.{:d}.{:d}.{:d}", bytes[0], bytes[1], bytes[2], bytes[3]);
+    }
+}
+
+void FlightRecorder::setup(uint32_t threshold, size_t capacity)
+{
+    m_threshold = threshold;
+    m_capacity = std::max<size_t>(capacity, 1);
+    m_slots.reset(new Slot[m_capacity]);
+}
+
+void FlightRecorder::record(const SlowLogin& login)
+{
+    Slot& slot = m_slots[m_next.fetch_add(1, std::memory_order_relaxed) % m_capacity];
+
+    // another writer lapped the ring onto this slot, drop rather than wait
+    uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) != 0 || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return;
+    }
+
+    // the word stores must not become visible before the odd sequence,
+    // read() would take a half written slot for the old even one
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::array<uint64_t, WORDS> words{};
+    memcpy(words.data(), &login, sizeof(login));
+    for (size_t i = 0; i < WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool FlightRecorder::read(const Slot& slot, SlowLogin& login) const
+{
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        } else if ((before & 1) != 0) {
+            continue;
+        }
+
+        std::array<uint64_t, WORDS> words;
+        for (size_t i = 0; i < WORDS; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            memcpy(&login, words.data(), sizeof(login));
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string FlightRecorder::dump() const
+{
+    std::vector<SlowLogin> logins;
+    for (size_t i = 0; i < m_capacity; ++i) {
+        SlowLogin login{};
+        if (read(m_slots[i], login)) {
+            logins.push_back(login);
+        }
+    }
+
+    std::sort(logins.begin(), logins.end(), [](const SlowLogin& a, const SlowLogin& b) {
+        return a.total > b.total;
+    });
+
+    fmt::memory_buffer out;
+    fmt::format_to(std::back_inserter(out), "{:d} logins over {:d} ms, times in us\n", logins.size(), m_threshold);
+    fmt::format_to(std::back_inserter(out), "{:<24s} {:<15s} {:>8s} {:<8s} {:>6s} {:>10s} {:>10s}",
+        "time", "ip", "account", "result", "rows", "lag", "total");
+    for (const char* name : STAGE_NAMES) {
+        fmt::format_to(std::back_inserter(out), " {:>10s}", name);
+    }
+    fmt::format_to(std::back_inserter(out), "\n");
+
+    for (const SlowLogin& login : logins) {
+        const std::time_t seconds = static_cast<std::time_t>(login.timestamp / 1000);
+        char time[32];
+        std::strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+
+        fmt::format_to(std::back_inserter(out), "{:s}.{:03d} {:<15s} {:>8d} {:<8s} {:>6d} {:>10d} {:>10d}",
+            time, login.timestamp % 1000, formatIp(login.ip), login.accountId, RESULT_NAMES[login.result], login.dbRows, login.dispatcherLag, login.total);
+        for (uint32_t stage : login.stages) {
+            fmt::format_to(std::back_inserter(out), " {:>10d}", stage);
+        }
+        fmt::format_to(std::back_inserter(out), "\n");
+    }
+    return fmt::to_string(out);
+}
+
+bool FlightRecorder::dumpToFile(const std::string& directory) const
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    const std::string path = fmt::format("{:s}/slow-logins-{:d}.txt", directory, std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    std::ofstream file(path);
+    file << dump();
+    if (!file) {
+        g_logger.error("[FlightRecorder] Failed to write {:s}", path);
+        return false;
+    }
+
+    g_logger.info("[FlightRecorder] Slow logins written to {:s}", path);
+    return true;
+}
+
+void LoginTimer::stage(LoginStage stage)
+{
+    const auto now = std::chrono::steady_clock::now();
+    m_login.stages[static_cast<size_t>(stage)] += toMicros(now - m_stageStart);
+    m_stageStart = now;
+}
+
+void LoginTimer::finish(FlightRecorder::Result result)
+{
+    if (!g_flightRecorder.isEnabled()) {
+        return;
+    }
+
+    m_login.total = toMicros(std::chrono::steady_clock::now() - m_start);
+    if (m_login.total < g_flightRecorder.getThreshold() * 1000) {
+        return;
+    }
+
+    m_login.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    m_login.dispatcherLag = g_dispatcher.getLastLag();
+    m_login.result = result;
+    g_flightRecorder.record(m_login);
+}
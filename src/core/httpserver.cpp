@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <core/httpserver.h>
+#include <core/logger.h>
+
+HttpServer g_httpServer;
+
+namespace
+{
+    constexpr size_t MAX_REQUEST_SIZE = 8192;
+    constexpr int32_t REQUEST_TIMEOUT = 5;
+
+    const char* getReason(int status)
+    {
+        switch (status) {
+            case 200: return "OK";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 409: return "Conflict";
+            case 500: return "Internal Server Error";
+            case 503: return "Service Unavailable";
+            default: return "Unknown";
+        }
+    }
+
+    std::string decodeComponent(const std::string& component)
+    {
+        std::string decoded;
+        decoded.reserve(component.size());
+        for (size_t i = 0; i < component.size(); ++i) {
+            if (component[i] == '+') {
+                decoded.push_back(' ');
+            } else if (component[i] == '%' && i + 2 < component.size() && isxdigit(component[i + 1]) && isxdigit(component[i + 2])) {
+                decoded.push_back(static_cast<char>(std::stoi(component.substr(i + 1, 2), nullptr, 16)));
+                i += 2;
+            } else {
+                decoded.push_back(component[i]);
+            }
+        }
+        return decoded;
+    }
+}
+
+struct HttpServer::Session
+{
+    explicit Session(boost::asio::io_context& ioContext) : socket(ioContext), timer(ioContext), buffer(MAX_REQUEST_SIZE) {}
+
+    boost::asio::ip::tcp::socket socket;
+    boost::asio::steady_timer timer;
+    boost::asio::streambuf buffer;
+    std::string response;
+};
+
+void HttpServer::addRoute(const std::string& path, HttpHandler handler)
+{
+    m_routes[path] = std::move(handler);
+}
+
+bool HttpServer::open(const std::string& host, int32_t port)
+{
+    try {
+        boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::make_address_v4(host), static_cast<unsigned short>(port));
+        m_acceptor.reset(new boost::asio::ip::tcp::acceptor(m_ioContext, endpoint));
+    } catch (boost::system::system_error& e) {
+        g_logger.error("[HttpServer] Failed to bind at address http://{:s}:{:d}: {:s}", host, port, e.what());
+        return false;
+    }
+
+    g_logger.info("[HttpServer] Listening on http://{:s}:{:d}", host, port);
+    accept();
+    return true;
+}
+
+void HttpServer::shutdown()
+{
+    boost::asio::post(m_ioContext, [this]() {
+        boost::system::error_code error;
+        if (m_acceptor) {
+            m_acceptor->close(error);
+        }
+        m_ioContext.stop();
+    });
+}
+
+void HttpServer::threadMain()
+{
+    m_ioContext.run();
+    setState(ThreadState::Terminated);
+}
+
+void HttpServer::accept()
+{
+    auto session = std::make_shared<Session>(m_ioContext);
+    m_acceptor->async_accept(session->socket, [this, session](const boost::system::error_code& error) {
+        if (error) {
+            if (error != boost::asio::error::operation_aborted) {
+                accept();
+            }
+            return;
+        }
+
+        session->timer.expires_after(std::chrono::seconds(REQUEST_TIMEOUT));
+        session->timer.async_wait([session](const boost::system::error_code& error) {
+            if (!error) {
+                boost::system::error_code ignored;
+                session->socket.close(ignored);
+            }
+        });
+
+        boost::asio::async_read_until(session->socket, session->buffer, "\r\n\r\n", [this, session](const boost::system::error_code& error, size_t) {
+            if (error) {
+                session->timer.cancel();
+                return;
+            }
+            onRequest(session);
+        });
+
+        accept();
+    });
+}
+
+void HttpServer::onRequest(const std::shared_ptr<Session>& session)
+{
+    std::istream stream(&session->buffer);
+    std::string requestLine;
+    std::getline(stream, requestLine);
+    if (!requestLine.empty() && requestLine.back() == '\r') {
+        requestLine.pop_back();
+    }
+
+    HttpRequest request = parseRequest(requestLine);
+    if (request.method.empty()) {
+        sendResponse(session, {400, "text/plain; charset=utf-8", "bad request\n"});
+        return;
+    }
+
+    auto it = m_routes.find(request.path);
+    if (it == m_routes.end()) {
+        sendResponse(session, {404, "text/plain; charset=utf-8", "not found\n"});
+        return;
+    }
+
+    HttpResponse response;
+    try {
+        response = it->second(request);
+    } catch (const std::exception& e) {
+        g_logger.error("[HttpServer] {:s} failed: {:s}", request.path, e.what());
+        response = {500, "text/plain; charset=utf-8", "internal error\n"};
+    }
+    sendResponse(session, response);
+}
+
+void HttpServer::sendResponse(const std::shared_ptr<Session>& session, const HttpResponse& response)
+{
+    session->response = fmt::format("HTTP/1.1 {:d} {:s}\r\nContent-Type: {:s}\r\nContent-Length: {:d}\r\nConnection: close\r\n\r\n",
+        response.status, getReason(response.status), response.contentType, response.body.size());
+    session->response += response.body;
+
+    boost::asio::async_write(session->socket, boost::asio::buffer(session->response), [session](const boost::system::error_code&, size_t) {
+        session->timer.cancel();
+        boost::system::error_code ignored;
+        session->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        session->socket.close(ignored);
+    });
+}
+
+HttpRequest HttpServer::parseRequest(const std::string& requestLine)
+{
+    // METHOD /path?key=value&... HTTP/1.x
+    HttpRequest request;
+    size_t methodEnd = requestLine.find(' ');
+    size_t targetEnd = requestLine.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || targetEnd == std::string::npos) {
+        return request;
+    }
+
+    std::string target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    size_t queryStart = target.find('?');
+    request.path = decodeComponent(target.substr(0, queryStart));
+
+    if (queryStart != std::string::npos) {
+        std::istringstream query(target.substr(queryStart + 1));
+        std::string parameter;
+        while (std::getline(query, parameter, '&')) {
+            size_t separator = parameter.find('=');
+            if (separator == std::string::npos) {
+                request.query[decodeComponent(parameter)] = "";
+            } else {
+                request.query[decodeComponent(parameter.substr(0, separator))] = decodeComponent(parameter.substr(separator + 1));
+            }
+        }
+    }
+
+    request.method = requestLine.substr(0, methodEnd);
+    return request;
+}
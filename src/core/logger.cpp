@@ -7,6 +7,8 @@
 
 #include "includes.h"
 
+#include <filesystem>
+
 #include <fmt/color.h>
 
 #include <core/logger.h>
@@ -24,73 +26,392 @@
 
 Logger g_logger;
 
+thread_local Logger::Ring* Logger::s_ring = nullptr;
+
+namespace
+{
+    constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(50);
+
+    const char* LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"};
+
+    fmt::text_style getLevelStyle(SeveretyLevel level)
+    {
+        switch (level) {
+            case SeveretyLevel::Trace: return fg(fmt::color::forest_green) | fmt::emphasis::bold;
+            case SeveretyLevel::Debug: return fg(fmt::color::dark_slate_blue) | fmt::emphasis::bold;
+            case SeveretyLevel::Warning: return fg(fmt::color::gold) | fmt::emphasis::bold;
+            case SeveretyLevel::Error:
+            case SeveretyLevel::Fatal: return fg(fmt::color::crimson) | fmt::emphasis::bold;
+            default: return fmt::emphasis::bold;
+        }
+    }
+}
+
 Logger::~Logger()
 {
-    for (auto log : m_logList) {
+    shutdown();
+    join();
+}
+
+Logger::Logger()
+{
+
+}
+
+bool Logger::parseLevel(const std::string& name, SeveretyLevel& level)
+{
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+
+    for (size_t i = 0; i < std::size(LEVEL_NAMES); ++i) {
+        if (upper == LEVEL_NAMES[i]) {
+            level = static_cast<SeveretyLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* Logger::getLevelName(SeveretyLevel level)
+{
+    return LEVEL_NAMES[static_cast<size_t>(level)];
+}
+
+void Logger::setFile(const std::string& path, size_t maxSize, uint32_t maxFiles)
+{
+    std::lock_guard<std::mutex> lockClass(m_writeLock);
+    m_filePath = path;
+    m_maxFileSize = maxSize;
+    m_maxFiles = maxFiles;
+    openFile();
+}
+
+Logger::Ring& Logger::getRing()
+{
+    if (!s_ring) {
+        std::lock_guard<std::mutex> lockClass(m_ringsLock);
+        m_rings.push_back(std::make_unique<Ring>());
+        s_ring = m_rings.back().get();
+    }
+    return *s_ring;
+}
+
+void Logger::addLog(SeveretyLevel level, std::string message)
+{
+    uint64_t suppressed = 0;
+    if (isEnabled(level) && acquireToken(std::hash<std::string>()(message), level, suppressed)) {
+        pushLog(level, std::move(message), suppressed);
+    }
+}
+
+bool Logger::acquireToken(uintptr_t key, SeveretyLevel level, uint64_t& suppressed)
+{
+    if (m_repeatRate == 0 || level == SeveretyLevel::Fatal) {
+        return true;
+    }
+
+    struct Bucket {
+        double tokens;
+        std::chrono::steady_clock::time_point refilled;
+        uint64_t suppressed;
+    };
+    thread_local std::unordered_map<uintptr_t, Bucket> buckets;
+
+    // distinct messages of the string overloads would grow it forever
+    if (buckets.size() >= MAX_REPEAT_BUCKETS) {
+        buckets.clear();
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    auto [it, inserted] = buckets.try_emplace(key, Bucket{m_repeatBurst, now, 0});
+    Bucket& bucket = it->second;
+    if (!inserted) {
+        const double elapsed = std::chrono::duration<double>(now - bucket.refilled).count();
+        bucket.tokens = std::min(m_repeatBurst, bucket.tokens + elapsed * m_repeatRate);
+        bucket.refilled = now;
+    }
+
+    if (bucket.tokens < 1) {
+        ++bucket.suppressed;
+        return false;
+    }
+
+    bucket.tokens -= 1;
+    suppressed = bucket.suppressed;
+    bucket.suppressed = 0;
+    return true;
+}
+
+void Logger::pushLog(SeveretyLevel level, std::string message, uint64_t suppressed)
+{
+    if (suppressed != 0) {
+        message += fmt::format(" ({:d} similar messages suppressed)", suppressed);
+    }
+
+    if (!m_running.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lockClass(m_writeLock);
+        writeLog(Log(level, std::move(message)));
+        std::fflush(stdout);
+        return;
+    }
+
+    Ring& ring = getRing();
+    const size_t head = ring.head.load(std::memory_order_relaxed);
+    while (head - ring.tail.load(std::memory_order_acquire) >= RING_SIZE) {
+        if (!m_running.load(std::memory_order_acquire)) {
+            // the writer is gone, nothing frees the ring anymore
+            writeQueued();
+            std::lock_guard<std::mutex> lockClass(m_writeLock);
+            writeLog(Log(level, std::move(message)));
+            std::fflush(stdout);
+            return;
+        }
+
+        // errors wait for the writer even with logOverflow = "drop"
+        if (m_overflow == Overflow::Drop && level < SeveretyLevel::Error) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        m_signal.notify_one();
+        std::this_thread::yield();
+    }
+
+    ring.entries[head % RING_SIZE] = Log(level, std::move(message));
+    ring.head.store(head + 1, std::memory_order_release);
+
+    // pairs with the fence in threadMain: either its last drain sees this
+    // entry or this thread sees the writer stopped and writes it itself
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_running.load(std::memory_order_relaxed)) {
+        writeQueued();
+        return;
+    }
+
+    // everything else is picked up by the next writer pass
+    if (level >= SeveretyLevel::Error) {
+        m_signal.notify_one();
+    }
+}
+
+void Logger::flush()
+{
+    std::unique_lock<std::mutex> lockClass(m_signalLock);
+    if (!m_running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    const uint64_t request = ++m_flushRequests;
+    m_signal.notify_one();
+    m_flushed.wait(lockClass, [this, request]() {
+        return m_flushesDone >= request || !m_running.load(std::memory_order_relaxed);
+    });
+}
+
+void Logger::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lockClass(m_signalLock);
+        m_stopping = true;
+    }
+    m_signal.notify_one();
+}
+
+void Logger::threadMain()
+{
+    m_running.store(true, std::memory_order_release);
+
+    std::vector<Log> batch;
+    std::unique_lock<std::mutex> signalLock(m_signalLock, std::defer_lock);
+    while (true) {
+        signalLock.lock();
+        const uint64_t flushRequests = m_flushRequests;
+        const bool stopping = m_stopping;
+        signalLock.unlock();
+
+        if (drain(batch)) {
+            writeLogs(batch);
+        }
+
+        signalLock.lock();
+        m_flushesDone = flushRequests;
+        m_flushed.notify_all();
+        if (stopping) {
+            break;
+        }
+        if (m_flushRequests == m_flushesDone && !m_stopping) {
+            m_signal.wait_for(signalLock, WRITER_INTERVAL);
+        }
+        signalLock.unlock();
+    }
+
+    // from here on logs are written by the calling thread
+    m_running.store(false, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_flushed.notify_all();
+    signalLock.unlock();
+
+    if (drain(batch)) {
+        writeLogs(batch);
+    }
+    setState(ThreadState::Terminated);
+}
+
+void Logger::writeQueued()
+{
+    std::vector<Log> batch;
+    if (drain(batch)) {
+        writeLogs(batch);
+    }
+}
+
+bool Logger::drain(std::vector<Log>& batch)
+{
+    {
+        std::lock_guard<std::mutex> lockClass(m_ringsLock);
+        for (const auto& ring : m_rings) {
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            const size_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                batch.push_back(std::move(ring->entries[tail % RING_SIZE]));
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    // every ring is in order, merge the threads by time
+    std::stable_sort(batch.begin(), batch.end(), [](const Log& a, const Log& b) {
+        return a.getTime() < b.getTime();
+    });
+    return !batch.empty();
+}
+
+void Logger::writeLogs(std::vector<Log>& batch)
+{
+    std::lock_guard<std::mutex> lockClass(m_writeLock);
+
+    const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+        writeLog(Log(SeveretyLevel::Warning, fmt::format("[Logger] {:d} messages dropped, log rings full", dropped - m_reportedDropped)));
+        m_reportedDropped = dropped;
+    }
+
+    for (const Log& log : batch) {
         writeLog(log);
-        delete log;
+    }
+    batch.clear();
+
+    std::fflush(stdout);
+    if (m_file.is_open()) {
+        m_file.flush();
     }
 }
 
-Logger::Logger()
+void Logger::writeLog(const Log& log)
+{
+    const SeveretyLevel level = log.getSeveretyLevel();
+    fmt::print(getLevelStyle(level), "[{:s}]: {:s}\n", getLevelName(level), log.getMessage());
+    m_written.fetch_add(1, std::memory_order_relaxed);
+
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    const auto time = log.getTime();
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+
+    const std::string line = fmt::format("{:s}.{:03d} [{:s}] {:s}\n", date, millis, getLevelName(level), log.getMessage());
+    m_file << line;
+    m_fileSize += line.size();
+
+    if (m_maxFileSize != 0 && m_fileSize >= m_maxFileSize) {
+        rotateFile();
+    }
+}
+
+void Logger::openFile()
 {
+    m_file.close();
+    if (m_filePath.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    const std::filesystem::path path(m_filePath);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
 
+    m_file.open(m_filePath, std::ios::out | std::ios::app);
+    if (!m_file.is_open()) {
+        fmt::print(getLevelStyle(SeveretyLevel::Error), "[ERROR]: [Logger] Failed to open {:s}\n", m_filePath);
+        return;
+    }
+
+    const auto size = std::filesystem::file_size(path, ec);
+    m_fileSize = ec ? 0 : static_cast<size_t>(size);
 }
 
-void Logger::addLog(Log* log)
+void Logger::rotateFile()
 {
-    // if the list is empty we have to signal it
-    bool do_signal = m_logList.empty();
+    m_file.close();
 
-    // add log to the queue
-    m_logList.push_back(log);
+    // loginserver.log -> loginserver.log.1 -> ... -> loginserver.log.<logMaxFiles>
+    std::error_code ec;
+    if (m_maxFiles == 0) {
+        std::filesystem::remove(m_filePath, ec);
+    } else {
+        for (uint32_t i = m_maxFiles - 1; i >= 1; --i) {
+            std::filesystem::rename(fmt::format("{:s}.{:d}", m_filePath, i), fmt::format("{:s}.{:d}", m_filePath, i + 1), ec);
+        }
+        std::filesystem::rename(m_filePath, m_filePath + ".1", ec);
+    }
+
+    openFile();
 }
 
-void Logger::writeLog(Log* log)
+void Logger::log(const std::string& message)
 {
-    // TODO Write Log
+    addLog(SeveretyLevel::Info, message);
 }
 
 void Logger::trace(const std::string& message)
 {
-    fmt::print(fg(fmt::color::forest_green) | fmt::emphasis::bold, "[TRACE]: {:s}\n", message);
-    std::cout << std::flush;
-    //addLog(new Log(SeveretyLevel::Trace, message));
+    if constexpr (static_cast<int>(SeveretyLevel::Trace) >= LOGGER_MIN_LEVEL) {
+        addLog(SeveretyLevel::Trace, message);
+    }
 }
 
 void Logger::debug(const std::string& message)
 {
-    fmt::print(fg(fmt::color::dark_slate_blue) | fmt::emphasis::bold, "[DEBUG]: {:s}\n", message);
-    std::cout << std::flush;
-    //addLog(new Log(SeveretyLevel::Debug, message));
+    if constexpr (static_cast<int>(SeveretyLevel::Debug) >= LOGGER_MIN_LEVEL) {
+        addLog(SeveretyLevel::Debug, message);
+    }
 }
 
 void Logger::info(const std::string& message)
 {
-    fmt::print(fmt::emphasis::bold, "[INFO]: {:s}\n", message);
-    std::cout << std::flush;
-    //addLog(new Log(SeveretyLevel::Info, message));
+    addLog(SeveretyLevel::Info, message);
 }
 
 void Logger::warning(const std::string& message)
 {
-    fmt::print(fg(fmt::color::gold) | fmt::emphasis::bold, "[WARNING]: {:s}\n", message);
-    std::cout << std::flush;
-    //addLog(new Log(SeveretyLevel::Warning, message));
+    addLog(SeveretyLevel::Warning, message);
 }
 
 void Logger::error(const std::string& message)
 {
-    fmt::print(fg(fmt::color::crimson) | fmt::emphasis::bold, "[ERROR]: {:s}\n", message);
-    std::cout << std::flush;
-    //addLog(new Log(SeveretyLevel::Error, message));
+    addLog(SeveretyLevel::Error, message);
 }
 
 void Logger::fatal(const std::string& message)
 {
-    fmt::print(fg(fmt::color::crimson) | fmt::emphasis::bold, "[FATAL]: {:s}\n", message);
-    std::cout << std::flush;
-    //addLog(new Log(SeveretyLevel::Fatal, message));
+    // the caller is usually about to exit
+    addLog(SeveretyLevel::Fatal, message);
+    flush();
 }
 
 void Logger::printBacktrace(int level)
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <core/metrics.h>
+
+Metrics g_metrics;
+
+uint64_t MetricCounter::value() const
+{
+    uint64_t total = 0;
+    for (const Shard& shard : m_shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t MetricHistogram::getBucket(uint64_t micros)
+{
+    if (micros < SUB_BUCKETS) {
+        return static_cast<size_t>(micros);
+    }
+
+    size_t exponent = 0;
+    while ((micros >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKETS;
+    }
+
+    // 4 sub-buckets: the two bits after the leading one
+    return SUB_BUCKETS + (exponent - 2) * SUB_BUCKETS + ((micros >> (exponent - 2)) & (SUB_BUCKETS - 1));
+}
+
+uint64_t MetricHistogram::getUpperBound(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket + 1;
+    }
+
+    const size_t exponent = 2 + (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    const size_t subBucket = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+    return static_cast<uint64_t>(SUB_BUCKETS + subBucket + 1) << (exponent - 2);
+}
+
+MetricHistogram::Snapshot MetricHistogram::snapshot() const
+{
+    Snapshot snapshot;
+    for (const Shard& shard : m_shards) {
+        for (size_t bucket = 0; bucket <= BUCKETS; ++bucket) {
+            snapshot.counts[bucket] += shard.counts[bucket].load(std::memory_order_relaxed);
+        }
+        snapshot.sumMicros += shard.sumMicros.load(std::memory_order_relaxed);
+    }
+
+    // from the buckets, so the +Inf bucket always matches the count
+    for (uint64_t count : snapshot.counts) {
+        snapshot.count += count;
+    }
+    return snapshot;
+}
+
+Metrics::Metrics()
+{
+    add({"loginserver_connections_accepted_total", "Accepted client connections.", Type::Counter, "", &connectionsAccepted});
+    add({"loginserver_network_received_bytes_total", "Bytes received from clients.", Type::Counter, "", &bytesReceived});
+    add({"loginserver_network_sent_bytes_total", "Bytes sent to clients.", Type::Counter, "", &bytesSent});
+
+    add({"loginserver_logins_total", "Login attempts by result.", Type::Counter, "{result=\"ok\"}", &loginsSucceeded});
+    add({"loginserver_logins_total", "Login attempts by result.", Type::Counter, "{result=\"failed\"}", &loginsFailed});
+    add({"loginserver_logins_total", "Login attempts by result.", Type::Counter, "{result=\"rejected\"}", &loginsRejected});
+
+    add({"loginserver_rsa_decrypt_seconds", "RSA decryption of the login packet.", Type::Histogram, "", nullptr, nullptr, &rsaDecryptTime});
+    add({"loginserver_database_query_seconds", "MySQL queries, including the wait for the connection.", Type::Histogram, "", nullptr, nullptr, &databaseQueryTime});
+    add({"loginserver_redis_publish_seconds", "Redis PUBLISH round trips.", Type::Histogram, "", nullptr, nullptr, &redisPublishTime});
+
+    add({"loginserver_dispatcher_lag_seconds", "Time tasks waited in the dispatcher queue.", Type::Histogram, "", nullptr, nullptr, &dispatcherLag});
+    add({"loginserver_lua_callback_seconds", "Module event callbacks and coroutine resumes.", Type::Histogram, "", nullptr, nullptr, &luaCallbackTime});
+
+    add({"loginserver_lua_memory_bytes", "Lua heap after the last collection cycle.", Type::Gauge, "", nullptr, &luaMemory});
+    add({"loginserver_lua_gc_cycle_seconds", "Time spent in the idle steps of a Lua collection cycle.", Type::Histogram, "", nullptr, nullptr, &luaGcCycleTime});
+}
+
+void Metrics::add(Entry entry)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_entries.push_back(std::move(entry));
+}
+
+void Metrics::addCallbackGauge(const std::string& name, const std::string& help, std::function<double()> callback)
+{
+    Entry entry{name, help, Type::Gauge};
+    entry.callback = std::move(callback);
+    add(std::move(entry));
+}
+
+void Metrics::addCallbackCounter(const std::string& name, const std::string& help, std::function<double()> callback)
+{
+    Entry entry{name, help, Type::Counter};
+    entry.callback = std::move(callback);
+    add(std::move(entry));
+}
+
+std::string Metrics::render() const
+{
+    static const char* TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    fmt::memory_buffer out;
+    const std::string* lastName = nullptr;
+    for (const Entry& entry : m_entries) {
+        // labelled series of one metric share the header
+        if (!lastName || *lastName != entry.name) {
+            fmt::format_to(std::back_inserter(out), "# HELP {:s} {:s}\n# TYPE {:s} {:s}\n", entry.name, entry.help, entry.name, TYPE_NAMES[static_cast<int>(entry.type)]);
+            lastName = &entry.name;
+        }
+
+        if (entry.callback) {
+            fmt::format_to(std::back_inserter(out), "{:s}{:s} {}\n", entry.name, entry.labels, entry.callback());
+        } else if (entry.counter) {
+            fmt::format_to(std::back_inserter(out), "{:s}{:s} {:d}\n", entry.name, entry.labels, entry.counter->value());
+        } else if (entry.gauge) {
+            fmt::format_to(std::back_inserter(out), "{:s}{:s} {:d}\n", entry.name, entry.labels, entry.gauge->value());
+        } else if (entry.histogram) {
+            MetricHistogram::Snapshot snapshot = entry.histogram->snapshot();
+            uint64_t cumulative = 0;
+            for (size_t bucket = 0; bucket < MetricHistogram::BUCKETS; ++bucket) {
+                cumulative += snapshot.counts[bucket];
+                // le is inclusive, the largest whole microsecond below the exclusive bound
+                fmt::format_to(std::back_inserter(out), "{:s}_bucket{{le=\"{}\"}} {:d}\n", entry.name, (MetricHistogram::getUpperBound(bucket) - 1) / 1e6, cumulative);
+            }
+            fmt::format_to(std::back_inserter(out), "{:s}_bucket{{le=\"+Inf\"}} {:d}\n", entry.name, snapshot.count);
+            fmt::format_to(std::back_inserter(out), "{:s}_sum {}\n{:s}_count {:d}\n", entry.name, snapshot.sumMicros / 1e6, entry.name, snapshot.count);
+        }
+    }
+    return fmt::to_string(out);
+}
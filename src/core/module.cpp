@@ -18,9 +18,10 @@
 #include <script/lua.h>
 
 Module::Module(ModuleManager* manager, const std::string& name, const std::string& path)
-    : m_manager(manager), m_name(name), m_path(path)
+    : m_name(name), m_path(path), m_manager(manager)
 {
     m_sandboxEnv = g_lua->newSandboxEnv();
+    m_memoryOwner = g_lua->getAllocator().registerOwner(name);
 }
 
 void Module::loadDependencies()
@@ -57,7 +58,7 @@ bool Module::loadFiles()
     lua_getglobal(L, "files");
 
     if (!g_lua->isTable(L, -1)) {
-        g_logger.error(fmt::format("[Module::loadFiles] ({:s}) Not found 'files' table in settings.lua", getName()));
+        g_logger.error("[Module::loadFiles] ({:s}) Not found 'files' table in settings.lua", getName());
         lua_pop(L, 1);
         return false;
     }
@@ -73,7 +74,7 @@ bool Module::loadFiles()
 
     for (auto it = moduleFiles.begin(); it != moduleFiles.end(); ++it) {
         if (!std::filesystem::is_regular_file(*it)) {
-            g_logger.error(fmt::format("[Module::loadFiles] ({:s}) Not found file {:s}", getName(), it->filename().string()));
+            g_logger.error("[Module::loadFiles] ({:s}) Not found file {:s}", getName(), it->filename().string());
             continue;
         }
 
@@ -83,7 +84,7 @@ bool Module::loadFiles()
         lua_setglobal(L, "init");
 
         if (g_lua->loadFile(scriptFile) == -1) {
-            g_logger.error(fmt::format("[Module::loadFiles] ({:s}) Failed to load {:s}", getName(), it->filename().string()));
+            g_logger.error("[Module::loadFiles] ({:s}) Failed to load {:s}", getName(), it->filename().string());
             g_logger.trace(g_lua->getLastLuaError());
             continue;
         }
@@ -104,6 +105,7 @@ bool Module::load()
 {
     int64_t lastTime = OTSYS_TIME();
     lua_State* L = g_lua->getLuaState();
+    LuaAllocator::OwnerScope memoryScope(g_lua->getAllocator(), m_memoryOwner);
 
     g_lua->setGlobalEnvironment(m_sandboxEnv);
 
@@ -115,7 +117,7 @@ bool Module::load()
     // load module files
     const auto dir = m_path.c_str();
     if (!std::filesystem::exists(dir) || !std::filesystem::is_directory(dir)) {
-        g_logger.error(fmt::format("[Module::load] ({:s}) Can not load folder '{:s}.'", getName(), m_path));
+        g_logger.error("[Module::load] ({:s}) Can not load folder '{:s}.'", getName(), m_path);
         return false;
     }
 
@@ -123,12 +125,12 @@ bool Module::load()
     std::filesystem::path settingsPath = modulePath / "settings.lua";
 
     if (!std::filesystem::is_regular_file(settingsPath)) {
-        g_logger.error(fmt::format("[Module::load] ({:s}) Not found settings.lua", getName()));
+        g_logger.error("[Module::load] ({:s}) Not found settings.lua", getName());
         return false;
     }
 
     if (g_lua->loadFile(settingsPath.string()) == -1) {
-        g_logger.error(fmt::format("[Module::load] ({:s}) Failed to load settings.lua", getName()));
+        g_logger.error("[Module::load] ({:s}) Failed to load settings.lua", getName());
         g_logger.trace(g_lua->getLastLuaError());
         return false;
     }
@@ -136,7 +138,7 @@ bool Module::load()
     if (hasDependencies()) {
         for (const std::string& moduleName : m_dependencies) {
             if (!m_manager->isModuleLoaded(moduleName)) {
-                g_logger.error(fmt::format("[Module::load] ({:s}) The dependency {:s} is not loaded.", getName(), moduleName));
+                g_logger.error("[Module::load] ({:s}) The dependency {:s} is not loaded.", getName(), moduleName);
                 return false;
             }
         }
@@ -145,7 +147,7 @@ bool Module::load()
     if (!loadFiles())
         return false;
 
-    g_logger.info(fmt::format("[Module] {:s} loaded ({:.2f}ms)", m_name, double(OTSYS_TIME() - lastTime)));
+    g_logger.info("[Module] {:s} loaded ({:.2f}ms, {:d} KB)", m_name, double(OTSYS_TIME() - lastTime), g_lua->getAllocator().getOwnerStats(m_memoryOwner).bytes / 1024);
 
     g_lua->resetGlobalEnvironment();
 
@@ -155,12 +157,20 @@ bool Module::load()
 
 void Module::unload()
 {
+    LuaAllocator::OwnerScope memoryScope(g_lua->getAllocator(), m_memoryOwner);
     g_lua->callSandboxLuaFieldNoRet("terminate", m_sandboxEnv);
     freeConnections();
 }
 
 bool Module::connect(const std::string& event, int32_t callback, const std::string& identifier)
 {
+    if (m_retired) {
+        // coroutine of a reloaded module version resumed after the swap
+        g_logger.warning("[Module::{:s}] Ignored connect to {:s} from a reloaded version.", m_name, event);
+        luaL_unref(g_lua->getLuaState(), LUA_REGISTRYINDEX, callback);
+        return false;
+    }
+
     if (identifier.empty()){
         auto& callbacks = m_eventCallbacks[event];
         callbacks.push_back(callback);
@@ -174,7 +184,7 @@ bool Module::connect(const std::string& event, int32_t callback, const std::stri
         auto& eventMap = m_identifiedEventCallbacks[event];
 
         if (eventMap.find(identifier) != eventMap.end()) {
-            g_logger.error(fmt::format("[Module::{:s}] Error when trying to connect already connected event with identifier {:s}.\n", m_name, identifier));
+            g_logger.error("[Module::{:s}] Error when trying to connect already connected event with identifier {:s}.\n", m_name, identifier);
             return false;
         }
 
@@ -210,11 +220,12 @@ void Module::disconnect(const std::string& event, int32_t callback, bool clearLi
         lua_State* L = g_lua->getLuaState();
 
         auto& callbacks = m_eventCallbacks[event];
-
-        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(), [callback](int32_t callbackIt) {
-            return callbackIt == callback;
-        }), callbacks.end());
-
+        auto removed = std::remove(callbacks.begin(), callbacks.end(), callback);
+        // every connection holds its own reference, not only the last one
+        if (removed != callbacks.end()) {
+            luaL_unref(L, LUA_REGISTRYINDEX, callback);
+        }
+        callbacks.erase(removed, callbacks.end());
 
         if (callbacks.empty()) {
             auto& modules = moduleEvents[event];
@@ -223,7 +234,6 @@ void Module::disconnect(const std::string& event, int32_t callback, bool clearLi
                 return moduleIt == this;
             }), modules.end());
 
-            luaL_unref(L, LUA_REGISTRYINDEX, callback);
             m_eventCallbacks.erase(event);
         }
     }
@@ -305,12 +315,20 @@ void Module::freeConnections()
 
     auto& moduleExports = m_manager->m_moduleExports;
     if (moduleExports.find(this) != moduleExports.end()) {
+        for (const auto& [name, ref] : moduleExports[this]) {
+            g_lua->unref(ref);
+        }
         moduleExports[this].clear();
     }
 }
 
 bool Module::exportLua(const std::string& name, int32_t ref)
 {
+    if (m_retired) {
+        luaL_unref(g_lua->getLuaState(), LUA_REGISTRYINDEX, ref);
+        return false;
+    }
+
     auto& moduleExports = m_manager->m_moduleExports;
 
     if (moduleExports.find(this) == moduleExports.end()) {
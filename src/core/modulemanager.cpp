@@ -20,6 +20,10 @@ ModuleManager::~ModuleManager()
     for (auto module : m_modules) {
         delete module.second;
     }
+
+    for (Module* module : m_retiredModules) {
+        delete module;
+    }
 }
 
 bool ModuleManager::loadModules()
@@ -66,7 +70,7 @@ bool ModuleManager::loadModules()
 
     for (auto it = paths.begin(); it != paths.end(); ++it) {
         if (!std::filesystem::is_directory(*it)) {
-            g_logger.error(fmt::format("Not found module directory: {:s}", it->string()));
+            g_logger.error("Not found module directory: {:s}", it->string());
             continue;
         }
 
@@ -76,22 +80,241 @@ bool ModuleManager::loadModules()
         std::string moduleName = path.substr(lastBar + 1);
 
         Module* newModule = new Module(this, moduleName, path);
-        if (newModule->load())
+        if (newModule->load()) {
             m_modules.insert(std::make_pair(moduleName, newModule));
-        else
+            m_loadOrder.push_back(moduleName);
+        } else
             delete newModule;
     }
 
+    const BytecodeCache& bytecodeCache = g_lua->getBytecodeCache();
+    if (bytecodeCache.isEnabled()) {
+        g_logger.info("Lua bytecode cache: {:d} hits, {:d} misses", bytecodeCache.getHits(), bytecodeCache.getMisses());
+    }
+
     return true;
 }
 
+bool ModuleManager::reloadModule(const std::string& name)
+{
+    std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
+
+    auto it = m_modules.find(name);
+    if (it == m_modules.end()) {
+        g_logger.error("[ModuleManager::reloadModule] Module {:s} is not loaded", name);
+        return false;
+    }
+
+    Module* oldModule = it->second;
+    lua_State* L = g_lua->getLuaState();
+
+    // both versions are connected until the swap, no emit runs without the
+    // Lua lock so no event reaches both of them
+    Module* newModule = new Module(this, name, oldModule->getPath());
+    if (!newModule->load()) {
+        g_lua->resetGlobalEnvironment();
+        newModule->freeConnections();
+        m_moduleExports.erase(newModule);
+
+        // exports of the running version the failed one overwrote
+        lua_getglobal(L, "g_modules");
+        if (lua_istable(L, -1)) {
+            lua_getfield(L, -1, name.c_str());
+            if (lua_istable(L, -1)) {
+                for (const auto& [exportName, ref] : m_moduleExports[oldModule]) {
+                    g_lua->getRef(ref);
+                    lua_setfield(L, -2, exportName.c_str());
+                }
+            }
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+
+        retireModule(newModule);
+        g_logger.error("[ModuleManager::reloadModule] Failed to reload {:s}, keeping the running version", name);
+        return false;
+    }
+
+    // onReload({env = <old sandbox env>}) migrates state into the new version
+    {
+        LuaAllocator::OwnerScope memoryScope(g_lua->getAllocator(), newModule->getMemoryOwner());
+        lua_createtable(L, 0, 1);
+        g_lua->getRef(oldModule->getSandboxEnv());
+        lua_setfield(L, -2, "env");
+        int32_t tableRef = LuaScript::ref(L);
+        g_lua->callSandboxLuaFieldNoRetRef("onReload", tableRef, newModule->getSandboxEnv());
+        g_lua->resetGlobalEnvironment();
+        g_lua->unref(tableRef);
+    }
+
+    swapEventModules(oldModule, newModule);
+
+    // exports the new version dropped
+    auto& oldExports = m_moduleExports[oldModule];
+    auto& newExports = m_moduleExports[newModule];
+    lua_getglobal(L, "g_modules");
+    if (lua_istable(L, -1)) {
+        lua_getfield(L, -1, name.c_str());
+        if (lua_istable(L, -1)) {
+            for (const auto& exported : oldExports) {
+                if (newExports.find(exported.first) == newExports.end()) {
+                    lua_pushnil(L);
+                    lua_setfield(L, -2, exported.first.c_str());
+                }
+            }
+        }
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+
+    // terminate is not called, the new version took over its resources
+    retireModule(oldModule);
+
+    it->second = newModule;
+    return true;
+}
+
+void ModuleManager::reloadModules()
+{
+    std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
+    int64_t lastTime = OTSYS_TIME();
+
+    size_t reloaded = 0;
+    for (const std::string& name : m_loadOrder) {
+        if (reloadModule(name)) {
+            ++reloaded;
+        }
+    }
+
+    g_logger.info("Reloaded {:d}/{:d} modules ({:.2f}ms)", reloaded, m_loadOrder.size(), double(OTSYS_TIME() - lastTime));
+
+    releaseRetiredModules();
+}
+
+void ModuleManager::retireModule(Module* module)
+{
+    lua_State* L = g_lua->getLuaState();
+
+    module->freeConnections();
+    module->m_retired = true;
+    m_moduleExports.erase(module);
+
+    auto newWeakTable = [L]() {
+        lua_newtable(L);
+        lua_newtable(L);
+        lua_pushstring(L, "v");
+        lua_setfield(L, -2, "__mode");
+        lua_setmetatable(L, -2);
+        return LuaScript::ref(L);
+    };
+
+    if (m_retiredEnvs == -1) {
+        m_retiredEnvs = newWeakTable();
+        m_retiredHandles = newWeakTable();
+    }
+
+    // retiredEnvs[module] = env
+    g_lua->getRef(m_retiredEnvs);
+    lua_pushlightuserdata(L, module);
+    g_lua->getRef(module->m_sandboxEnv);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+
+    // retiredHandles[module] = env.module
+    g_lua->getRef(m_retiredHandles);
+    lua_pushlightuserdata(L, module);
+    g_lua->getRef(module->m_sandboxEnv);
+    lua_pushstring(L, "module");
+    lua_rawget(L, -2);
+    lua_remove(L, -2);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+
+    // from here on only its functions and suspended coroutines keep the env alive
+    g_lua->unref(module->m_sandboxEnv);
+    module->m_sandboxEnv = -1;
+    m_retiredModules.push_back(module);
+}
+
+void ModuleManager::releaseRetiredModules()
+{
+    if (m_retiredModules.empty()) {
+        return;
+    }
+
+    lua_State* L = g_lua->getLuaState();
+
+    // weak values are only cleared by a finished cycle
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    g_lua->getRef(m_retiredEnvs);
+    g_lua->getRef(m_retiredHandles);
+
+    size_t retired = m_retiredModules.size();
+    m_retiredModules.erase(std::remove_if(m_retiredModules.begin(), m_retiredModules.end(), [L](Module* module) {
+        lua_pushlightuserdata(L, module);
+        lua_rawget(L, -3);
+        bool referenced = !lua_isnil(L, -1);
+        lua_pop(L, 1);
+
+        if (referenced) {
+            return false;
+        }
+
+        // a table outside its env may still hold the `module` userdata,
+        // Module:connect sees a nil module from now on
+        lua_pushlightuserdata(L, module);
+        lua_rawget(L, -2);
+        if (Module** handle = LuaScript::getRawUserdata<Module>(L, -1)) {
+            *handle = nullptr;
+        }
+        lua_pop(L, 1);
+
+        lua_pushlightuserdata(L, module);
+        lua_pushnil(L);
+        lua_rawset(L, -3);
+
+        delete module;
+        return true;
+    }), m_retiredModules.end());
+
+    lua_pop(L, 2);
+
+    if (retired != m_retiredModules.size()) {
+        g_logger.info("Released {:d} retired module versions, {:d} still referenced by coroutines", retired - m_retiredModules.size(), m_retiredModules.size());
+    }
+}
+
+void ModuleManager::swapEventModules(Module* oldModule, Module* newModule)
+{
+    // the new version takes the position of the old one in every event,
+    // so callbacks keep running in module load order
+    auto swap = [oldModule, newModule](std::unordered_map<std::string, std::vector<Module*>>& events) {
+        for (auto& [event, modules] : events) {
+            auto oldIt = std::find(modules.begin(), modules.end(), oldModule);
+            auto newIt = std::find(modules.begin(), modules.end(), newModule);
+            if (oldIt == modules.end() || newIt == modules.end()) {
+                continue;
+            }
+
+            *oldIt = newModule;
+            modules.erase(newIt);
+        }
+    };
+
+    swap(m_moduleEvents);
+    swap(m_identifiedModuleEvents);
+}
+
 bool ModuleManager::isModuleLoaded(const std::string& name)
 {
+    std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
     return m_modules.find(name) != m_modules.end();
 }
 
 Module* ModuleManager::getModuleByName(const std::string& name)
 {
+    std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
     if (m_modules.find(name) != m_modules.end()) {
         return m_modules[name];
     }
@@ -100,6 +323,7 @@ Module* ModuleManager::getModuleByName(const std::string& name)
 
 void ModuleManager::removeAllConnectionsById(const std::string& identifier)
 {
+    std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
     for (auto it = m_identifiedModuleEvents.begin(); it != m_identifiedModuleEvents.end();) {
         auto& modules = it->second;
 
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include <core/scheduler.h>
+
+Scheduler g_scheduler;
+
+SchedulerTask* createSchedulerTask(uint32_t delay, TaskFunc&& f)
+{
+	return new SchedulerTask(std::max<uint32_t>(delay, SCHEDULER_MINTICKS), std::move(f));
+}
+
+void Scheduler::threadMain()
+{
+	std::unique_lock<std::mutex> eventLockUnique(m_eventLock, std::defer_lock);
+	while (getState() != ThreadState::Terminated) {
+		std::cv_status ret = std::cv_status::no_timeout;
+
+		eventLockUnique.lock();
+		if (m_eventList.empty()) {
+			m_eventSignal.wait(eventLockUnique);
+		} else {
+			ret = m_eventSignal.wait_until(eventLockUnique, m_eventList.top()->getCycle());
+		}
+
+		// the mutex is locked again now
+		if (ret == std::cv_status::timeout && !m_eventList.empty()) {
+			// ok we had a timeout, so there has to be an event we have to execute
+			SchedulerTask* task = m_eventList.top();
+			m_eventList.pop();
+
+			// check if the event was stopped
+			auto it = m_eventIds.find(task->getEventId());
+			if (it == m_eventIds.end()) {
+				eventLockUnique.unlock();
+				delete task;
+				continue;
+			}
+			m_eventIds.erase(it);
+			eventLockUnique.unlock();
+
+			task->setDontExpire();
+			g_dispatcher.addTask(task);
+		} else {
+			eventLockUnique.unlock();
+		}
+	}
+}
+
+uint32_t Scheduler::addEvent(SchedulerTask* task)
+{
+	bool do_signal;
+	m_eventLock.lock();
+
+	if (getState() != ThreadState::Running) {
+		m_eventLock.unlock();
+		delete task;
+		return 0;
+	}
+
+	// check if the event has a valid id
+	if (task->getEventId() == 0) {
+		// if not generate one
+		if (++m_lastEventId == 0) {
+			m_lastEventId = 1;
+		}
+
+		task->setEventId(m_lastEventId);
+	}
+
+	// insert the event id in the list of active events
+	uint32_t eventId = task->getEventId();
+	m_eventIds.insert(eventId);
+
+	// add the event to the queue
+	m_eventList.push(task);
+
+	// if the list was empty or this event is the top in the list
+	// we have to signal it
+	do_signal = (task == m_eventList.top());
+
+	m_eventLock.unlock();
+
+	if (do_signal) {
+		m_eventSignal.notify_one();
+	}
+
+	return eventId;
+}
+
+bool Scheduler::stopEvent(uint32_t eventId)
+{
+	if (eventId == 0) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lockClass(m_eventLock);
+
+	// search the event id
+	auto it = m_eventIds.find(eventId);
+	if (it == m_eventIds.end()) {
+		return false;
+	}
+
+	m_eventIds.erase(it);
+	return true;
+}
+
+void Scheduler::shutdown()
+{
+	setState(ThreadState::Terminated);
+	std::lock_guard<std::mutex> lockClass(m_eventLock);
+
+	// this list should already be empty
+	while (!m_eventList.empty()) {
+		delete m_eventList.top();
+		m_eventList.pop();
+	}
+
+	m_eventIds.clear();
+	m_eventSignal.notify_one();
+}
@@ -12,6 +12,7 @@
 
 #include <core/server.h>
 #include <core/logger.h>
+#include <core/metrics.h>
 
 Server::~Server()
 {
@@ -31,6 +32,8 @@ void Server::accept()
 void Server::onAccept(ConnectionSharedPtr connection, const boost::system::error_code& error)
 {
     if (!error) {
+        g_metrics.connectionsAccepted.inc();
+
         auto remote_ip = connection->getIP();
         if (remote_ip != 0) {
             connection->accept();
@@ -50,12 +53,12 @@ void Server::open(const std::string& ip, int32_t port)
         m_acceptor.reset(new boost::asio::ip::tcp::acceptor(m_io_context, endpoint));
         m_acceptor->set_option(boost::asio::ip::tcp::no_delay(true));
 
-        g_logger.info("Listening on tcp://" + ip + ":" + std::to_string(port));
+        g_logger.info("Listening on tcp://{:s}:{:d}", ip, port);
 
         accept();
         m_io_context.run();
     } catch (boost::system::system_error& e) {
-        g_logger.info("Failed to bind at address tcp://" + ip + ":" + std::to_string(port) + ": " + e.what());
+        g_logger.info("Failed to bind at address tcp://{:s}:{:d}: {:s}", ip, port, e.what());
     }
 }
 
@@ -10,9 +10,15 @@
 #include <core/signals.h>
 #include <core/logger.h>
 #include <core/tasks.h>
+#include <core/scheduler.h>
+#include <core/modulemanager.h>
+#include <core/httpserver.h>
+#include <core/flightrecorder.h>
 
 #include <database/database.h>
+#include <database/databasetasks.h>
 #include <network/connectionmanager.h>
+#include <network/trafficrecorder.h>
 
 #include <redis/redis.h>
 
@@ -21,6 +27,11 @@ Signals::Signals(boost::asio::io_context& io_context, ServerSharedPtr server) :
     m_server(server)
 {
     m_set.add(SIGINT);
+#ifndef _WIN32
+    m_set.add(SIGHUP);
+    m_set.add(SIGUSR1);
+    m_set.add(SIGUSR2);
+#endif
 
     asyncWait();
 }
@@ -29,7 +40,7 @@ void Signals::asyncWait()
 {
     m_set.async_wait([this] (boost::system::error_code err, int signal) {
         if (err) {
-            g_logger.error("Signal handling error: " + err.message());
+            g_logger.error("Signal handling error: {:s}", err.message());
             return;
         }
         dispatchSignalHandler(signal);
@@ -43,6 +54,17 @@ void Signals::dispatchSignalHandler(int signal)
         case SIGINT: //Shuts the server down
             sigintHandler();
             break;
+#ifndef _WIN32
+        case SIGHUP: //Reloads the modules
+            sighupHandler();
+            break;
+        case SIGUSR1: //Dumps the slow login flight recorder
+            sigusr1Handler();
+            break;
+        case SIGUSR2: //Dumps the Lua profiler data
+            sigusr2Handler();
+            break;
+#endif
         default:
             break;
     }
@@ -52,7 +74,51 @@ void Signals::sigintHandler()
 {
     g_logger.info("Gracefully stopping...");
     m_server.get()->close();
+    g_httpServer.shutdown();
+    g_httpServer.join();
+    g_scheduler.shutdown();
+    g_scheduler.join();
+    g_databaseTasks.shutdown();
+    g_databaseTasks.join();
     g_dispatcher.join();
     g_redis->joinThreads();
     g_connectionManager.closeAll();
+    g_trafficRecorder.stop();
+    g_logger.shutdown();
+    g_logger.join();
+}
+
+#ifndef _WIN32
+void Signals::sighupHandler()
+{
+    g_logger.info("Reloading modules...");
+    // between two dispatcher tasks, connections stay open
+    g_dispatcher.addTask(createTask([]() {
+        g_modules->reloadModules();
+    }));
+}
+
+void Signals::sigusr1Handler()
+{
+    if (!g_flightRecorder.isEnabled()) {
+        g_logger.info("Slow login recorder is disabled, set slowLoginThreshold");
+        return;
+    }
+    // file I/O stays off the io thread
+    g_dispatcher.addTask(createTask([]() {
+        g_flightRecorder.dumpToFile(g_config->get<std::string>("slowLoginDirectory", "profile"));
+    }));
+}
+
+void Signals::sigusr2Handler()
+{
+    g_dispatcher.addTask(createTask([]() {
+        LuaProfiler& profiler = g_lua->getProfiler();
+        if (!profiler.isEnabled()) {
+            g_logger.info("Lua profiler is not running, start it with luaProfiler = true or g_profiler.start()");
+            return;
+        }
+        profiler.dump(g_config->get<std::string>("luaProfilerDirectory", "profile"));
+    }));
 }
+#endif
@@ -6,6 +6,7 @@
  */
 
 #include <core/tasks.h>
+#include <core/metrics.h>
 
 Dispatcher g_dispatcher;
 
@@ -29,6 +30,13 @@ void Dispatcher::threadMain()
 		// check if there are tasks waiting
 		taskLockUnique.lock();
 		if (m_taskList.empty()) {
+			if (m_idleWork) {
+				// nothing queued, give the idle handler a slice and check again
+				taskLockUnique.unlock();
+				m_idleWork = m_idleHandler();
+				continue;
+			}
+
 			//if the list is empty wait for signal
 			m_taskSignal.wait(taskLockUnique);
 		}
@@ -36,13 +44,19 @@ void Dispatcher::threadMain()
 		taskLockUnique.unlock();
 
 		for (Task* task : tmpTaskList) {
+			const auto lag = std::chrono::steady_clock::now() - task->getEnqueued();
+			g_metrics.dispatcherLag.observe(lag);
+			m_lastLag.store(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(lag).count()), std::memory_order_relaxed);
 			if (!task->hasExpired()) {
-				++m_dispatcherCycle;
+				m_dispatcherCycle.fetch_add(1, std::memory_order_relaxed);
 				// execute it
 				(*task)();
 			}
 			delete task;
 		}
+		if (!tmpTaskList.empty() && m_idleHandler) {
+			m_idleWork = true;
+		}
 		tmpTaskList.clear();
 	}
 }
@@ -55,6 +69,7 @@ void Dispatcher::addTask(Task* task)
 
 	if (getState() == ThreadState::Running) {
 		do_signal = m_taskList.empty();
+		task->setEnqueued();
 		m_taskList.push_back(task);
 	} else {
 		delete task;
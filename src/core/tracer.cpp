@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <core/tracer.h>
+
+Tracer g_tracer;
+
+thread_local uint64_t Tracer::s_currentTrace = 0;
+thread_local Tracer::Ring* Tracer::s_ring = nullptr;
+
+void Tracer::setup(uint32_t sampleRate, size_t capacity)
+{
+    m_sampleRate = sampleRate;
+    m_capacity = std::max<size_t>(capacity, 1);
+}
+
+uint64_t Tracer::sample()
+{
+    if (m_sampleRate == 0) {
+        return 0;
+    }
+
+    const uint64_t connection = m_connections.fetch_add(1, std::memory_order_relaxed) + 1;
+    return connection % m_sampleRate == 0 ? connection : 0;
+}
+
+void Tracer::record(uint64_t trace, const char* name, int64_t start, int64_t end)
+{
+    push({name, trace, start, end, false});
+}
+
+void Tracer::recordAsync(uint64_t trace, const char* name, int64_t start, int64_t end)
+{
+    push({name, trace, start, end, true});
+}
+
+void Tracer::push(const Span& span)
+{
+    if (m_sampleRate == 0) {
+        return;
+    }
+
+    Ring& ring = getRing();
+    std::lock_guard<std::mutex> lock(ring.lock);
+    if (ring.spans.size() < m_capacity) {
+        ring.spans.push_back(span);
+    } else {
+        ring.spans[ring.next] = span;
+    }
+    ring.next = (ring.next + 1) % m_capacity;
+}
+
+Tracer::Ring& Tracer::getRing()
+{
+    if (!s_ring) {
+        std::lock_guard<std::mutex> lock(m_ringsLock);
+        m_rings.push_back(std::make_unique<Ring>());
+        s_ring = m_rings.back().get();
+        s_ring->tid = static_cast<uint32_t>(m_rings.size());
+        s_ring->spans.reserve(m_capacity);
+    }
+    return *s_ring;
+}
+
+std::string Tracer::dump() const
+{
+    std::vector<std::pair<uint32_t, Span>> spans;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsLock);
+        for (const auto& ring : m_rings) {
+            std::lock_guard<std::mutex> ringLock(ring->lock);
+            for (const Span& span : ring->spans) {
+                spans.emplace_back(ring->tid, span);
+            }
+        }
+    }
+
+    int64_t origin = std::numeric_limits<int64_t>::max();
+    for (const auto& [tid, span] : spans) {
+        origin = std::min(origin, span.start);
+    }
+
+    fmt::memory_buffer out;
+    fmt::format_to(std::back_inserter(out), "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            fmt::format_to(std::back_inserter(out), ",\n");
+        }
+        first = false;
+    };
+
+    for (const auto& [tid, span] : spans) {
+        // Chrome wants microseconds
+        const double ts = (span.start - origin) / 1e3;
+        const double dur = (span.end - span.start) / 1e3;
+
+        separator();
+        if (span.async) {
+            fmt::format_to(std::back_inserter(out),
+                "{{\"name\":\"{:s}\",\"cat\":\"login\",\"ph\":\"b\",\"id\":{:d},\"ts\":{:.3f},\"pid\":1,\"tid\":{:d}}},\n"
+                "{{\"name\":\"{:s}\",\"cat\":\"login\",\"ph\":\"e\",\"id\":{:d},\"ts\":{:.3f},\"pid\":1,\"tid\":{:d}}}",
+                span.name, span.trace, ts, tid, span.name, span.trace, ts + dur, tid);
+        } else {
+            fmt::format_to(std::back_inserter(out),
+                "{{\"name\":\"{:s}\",\"cat\":\"login\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{:d},\"args\":{{\"trace\":{:d}}}}}",
+                span.name, ts, dur, tid, span.trace);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_ringsLock);
+    for (const auto& ring : m_rings) {
+        separator();
+        fmt::format_to(std::back_inserter(out), "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{:d},\"args\":{{\"name\":\"thread {:d}\"}}}}", ring->tid, ring->tid);
+    }
+
+    fmt::format_to(std::back_inserter(out), "]}}\n");
+    return fmt::to_string(out);
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(m_ringsLock);
+    for (const auto& ring : m_rings) {
+        std::lock_guard<std::mutex> ringLock(ring->lock);
+        ring->spans.clear();
+        ring->next = 0;
+    }
+}
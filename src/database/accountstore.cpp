@@ -0,0 +1,19 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <database/accountstore.h>
+#include <script/lua.h>
+#include <utils/tools.h>
+
+AccountStorePtr g_accountStore;
+
+std::string AccountStore::hashPassword(const std::string& password)
+{
+    return transformToSHA1(g_config->get<std::string>("encryptionSalt") + password);
+}
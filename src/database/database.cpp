@@ -9,8 +9,9 @@
 
 #include <database/database.h>
 #include <core/logger.h>
+#include <core/metrics.h>
+#include <core/faultinjector.h>
 #include <script/lua.h>
-#include <utils/tools.h>
 
 Database g_database;
 
@@ -44,27 +45,74 @@ void Database::connect()
     }
 }
 
-DBResultSharedPtr Database::storeQuery(const std::string& query)
+bool Database::executeQuery(const std::string& query, std::unique_lock<std::recursive_mutex>& lock)
 {
-    m_databaseLock.lock();
+    if (!m_handle) {
+        // accountStore = "memory" runs without MySQL
+        g_logger.error("[Database::executeQuery]: not connected");
+        return false;
+    }
+
+    lock.lock();
+    if (m_streaming) {
+        // the recursive lock lets the owning thread in, mysql would answer "Commands out of sync"
+        g_logger.error("[Database::executeQuery]: a streaming result is still open");
+        lock.unlock();
+        return false;
+    }
+
+    if (!g_faultInjector.inject(FaultTarget::Database)) {
+        g_logger.error("[Database::executeQuery]: injected failure");
+        lock.unlock();
+        return false;
+    }
+
     if (mysql_real_query(m_handle, query.c_str(), query.length()) != 0) {
-        g_logger.error("[mysql_real_query]: " + std::string(mysql_error(m_handle)));
-        m_databaseLock.unlock();
+        g_logger.error("[mysql_real_query]: {:s}", mysql_error(m_handle));
+        lock.unlock();
+        return false;
+    }
+    return true;
+}
+
+DBResultSharedPtr Database::storeQuery(const std::string& query)
+{
+    MetricTimer queryTimer(g_metrics.databaseQueryTime);
+    std::unique_lock<std::recursive_mutex> lock(m_databaseLock, std::defer_lock);
+    if (!executeQuery(query, lock)) {
         return nullptr;
     }
 
     MYSQL_RES* result = mysql_store_result(m_handle);
     if (!result) {
-        g_logger.error("[mysql_store_result]: " + std::string(mysql_error(m_handle)));
-        m_databaseLock.unlock();
+        g_logger.error("[mysql_store_result]: {:s}", mysql_error(m_handle));
         return nullptr;
     }
-    m_databaseLock.unlock();
+    lock.unlock();
 
     DBResultSharedPtr res = std::make_shared<DBResult>(result);
     return res->hasNext() ? res : nullptr;
 }
 
+DBResultPtr Database::useQuery(const std::string& query)
+{
+    MetricTimer queryTimer(g_metrics.databaseQueryTime);
+    std::unique_lock<std::recursive_mutex> lock(m_databaseLock, std::defer_lock);
+    if (!executeQuery(query, lock)) {
+        return nullptr;
+    }
+
+    MYSQL_RES* result = mysql_use_result(m_handle);
+    if (!result) {
+        g_logger.error("[mysql_use_result]: {:s}", mysql_error(m_handle));
+        return nullptr;
+    }
+
+    // unlike storeQuery an empty result is returned, hasNext() is false
+    m_streaming = true;
+    return std::make_unique<DBResult>(result, std::move(lock), &m_streaming);
+}
+
 std::string Database::escapeString(const std::string& string) const
 {
     // the worst case is 2n + 1
@@ -77,7 +125,11 @@ std::string Database::escapeString(const std::string& string) const
 
     if (length != 0) {
         char* output = new char[maxLength];
-        mysql_real_escape_string(m_handle, output, string.c_str(), length);
+        if (m_handle) {
+            mysql_real_escape_string(m_handle, output, string.c_str(), length);
+        } else {
+            mysql_escape_string(output, string.c_str(), length);
+        }
         escaped.append(output);
         delete[] output;
     }
@@ -85,48 +137,3 @@ std::string Database::escapeString(const std::string& string) const
     escaped.push_back('\'');
     return escaped;
 }
-
-Account Database::getAccount(const std::string& email, const std::string& password)
-{
-    Account account;
-
-    auto accountInfo = getAccountInfo(email, password);
-    if (!accountInfo) {
-        return account;
-    }
-
-    account.email = email;
-    account.password = password;
-    account.id = accountInfo->getNumber<uint16_t>("id");
-    account.premiumEnd = accountInfo->getNumber<uint64_t>("premium_ends_at");
-    account.characters = getCharacterList(account.id);
-
-    return account;
-}
-
-DBResultSharedPtr Database::getAccountInfo(const std::string& email, const std::string& password)
-{
-    std::string hashPass = transformToSHA1(g_config->get<std::string>("encryptionSalt") + password);
-    auto result = storeQuery("SELECT `id`, `email`, `password`, `premium_ends_at` FROM `accounts` WHERE `email` = " + escapeString(email) + " AND password = " + escapeString(hashPass));
-    return result;
-}
-
-std::vector<Character> Database::getCharacterList(uint16_t accountId)
-{
-    std::vector<Character> characters;
-
-    auto result = storeQuery("SELECT `name`, `account_id`, `level`, `instance_id`, `instance_name`, `auto_reconnect` FROM `players` WHERE `account_id` = '" + std::to_string(accountId) + "'");
-    if (result) {
-        while(result->hasNext()) {
-            Character character;
-            character.name = result->getString("name");
-            character.instanceName = result->getString("instance_name");
-            character.instanceId = result->getString("instance_id");
-            character.level = result->getNumber<uint16_t>("level");
-            character.autoReconnect = static_cast<bool>(result->getNumber<int>("auto_reconnect"));
-            characters.push_back(character);
-            result->next();
-        }
-    }
-    return characters;
-}
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <database/databasetasks.h>
+#include <database/database.h>
+
+#include <core/tasks.h>
+
+DatabaseTasks g_databaseTasks;
+
+void DatabaseTasks::threadMain()
+{
+    std::unique_lock<std::mutex> taskLockUnique(m_taskLock, std::defer_lock);
+    while (getState() != ThreadState::Terminated) {
+        taskLockUnique.lock();
+        if (m_tasks.empty()) {
+            m_taskSignal.wait(taskLockUnique);
+        }
+
+        if (m_tasks.empty()) {
+            taskLockUnique.unlock();
+            continue;
+        }
+
+        DatabaseTask task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        taskLockUnique.unlock();
+
+        DBResultSharedPtr result = g_database.storeQuery(task.query);
+        if (task.callback) {
+            g_dispatcher.addTask(createTask([callback = std::move(task.callback), result]() {
+                callback(result);
+            }));
+        }
+    }
+}
+
+bool DatabaseTasks::addTask(std::string query, Callback callback)
+{
+    bool do_signal = false;
+
+    m_taskLock.lock();
+    if (getState() != ThreadState::Running) {
+        m_taskLock.unlock();
+        return false;
+    }
+
+    do_signal = m_tasks.empty();
+    m_tasks.push_back({std::move(query), std::move(callback)});
+    m_taskLock.unlock();
+
+    if (do_signal) {
+        m_taskSignal.notify_one();
+    }
+    return true;
+}
+
+void DatabaseTasks::shutdown()
+{
+    std::lock_guard<std::mutex> lockClass(m_taskLock);
+    setState(ThreadState::Terminated);
+    m_taskSignal.notify_one();
+}
@@ -9,39 +9,45 @@
 
 #include <database/dbresult.h>
 
-DBResult::DBResult(MYSQL_RES* res)
+DBResult::DBResult(MYSQL_RES* res, std::unique_lock<std::recursive_mutex> connectionLock/* = {}*/, bool* streaming/* = nullptr*/) :
+    m_handle(res), m_connectionLock(std::move(connectionLock)), m_streaming(streaming)
 {
-    size_t i = 0;
-
-    auto field = mysql_fetch_field(res);
-    while (field) {
-        m_fields[field->name] = i++;
-        field = mysql_fetch_field(res);
+    const unsigned int count = mysql_num_fields(res);
+    const MYSQL_FIELD* fields = mysql_fetch_fields(res);
+    m_columns.reserve(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        m_columns.emplace_back(fields[i].name);
     }
 
-    auto row = mysql_fetch_row(res);
-    while (row) {
-        m_rows.push_back(row);
-        row = mysql_fetch_row(res);
-    }
+    next();
 }
 
-std::string DBResult::getString(const std::string& field)
+DBResult::~DBResult()
 {
-    if (m_rows.empty() || m_rows.size() < m_index) {
-        return "";
+    // a streaming result reads the rows left on the connection before the lock is released
+    if (m_handle) {
+        mysql_free_result(m_handle);
     }
-
-    auto it = m_fields.find(field);
-    if (it == m_fields.end()) {
-        // field name doesnt exist
-        return "";
+    if (m_streaming) {
+        *m_streaming = false;
     }
+}
 
-    auto row = m_rows[m_index];
-    if (row[it->second] == nullptr) {
-        return "";
+size_t DBResult::getColumnIndex(std::string_view name) const
+{
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        if (m_columns[i] == name) {
+            return i;
+        }
     }
+    return npos;
+}
 
-    return std::string(row[it->second]);
+MYSQL_RES* DBResult::release()
+{
+    MYSQL_RES* res = m_handle;
+    m_handle = nullptr;
+    m_row = nullptr;
+    m_lengths = nullptr;
+    return res;
 }
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <database/memoryaccountstore.h>
+#include <core/faultinjector.h>
+#include <core/tracer.h>
+#include <utils/tools.h>
+
+namespace
+{
+    uint64_t parseNumber(const std::string& value, uint64_t max)
+    {
+        size_t end = 0;
+        uint64_t number = std::stoull(value, &end);
+        if (end != value.size() || number > max) {
+            throw std::out_of_range(value);
+        }
+        return number;
+    }
+}
+
+void MemoryAccountStore::load(const std::string& path)
+{
+    std::ifstream file{path};
+    if (!file.is_open()) {
+        throw std::runtime_error("Missing file " + path);
+    }
+
+    size_t lineNumber = 0;
+    std::vector<std::string> fields;
+    for (std::string line; std::getline(file, line);) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        boost::split(fields, line, boost::is_any_of("\t"));
+        try {
+            if (fields[0] == "account" && fields.size() == 5) {
+                AccountEntry entry;
+                entry.id = static_cast<uint16_t>(parseNumber(fields[1], UINT16_MAX));
+                entry.plain = boost::starts_with(fields[3], "plain:");
+                entry.password = entry.plain ? fields[3].substr(6) : boost::to_lower_copy(fields[3]);
+                entry.premiumEnd = parseNumber(fields[4], UINT64_MAX);
+                if (!m_accounts.emplace(fields[2], std::move(entry)).second) {
+                    throw std::runtime_error("duplicate email " + fields[2]);
+                }
+            } else if (fields[0] == "player" && fields.size() == 7) {
+                Character character;
+                character.name = fields[2];
+                character.level = static_cast<uint16_t>(parseNumber(fields[3], UINT16_MAX));
+                character.instanceId = fields[4];
+                character.instanceName = fields[5];
+                character.autoReconnect = parseNumber(fields[6], 1) != 0;
+                m_characters[static_cast<uint16_t>(parseNumber(fields[1], UINT16_MAX))].push_back(std::move(character));
+            } else {
+                throw std::runtime_error("unknown record");
+            }
+        } catch (const std::logic_error& e) {
+            throw std::runtime_error(fmt::format("{:s}:{:d}: invalid number {:s}", path, lineNumber, e.what()));
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error(fmt::format("{:s}:{:d}: {:s}", path, lineNumber, e.what()));
+        }
+    }
+}
+
+void MemoryAccountStore::simulateLatency() const
+{
+    if (m_latency == 0 && m_jitter == 0) {
+        return;
+    }
+
+    uint32_t latency = m_latency;
+    if (m_jitter != 0) {
+        thread_local std::mt19937 random{std::random_device{}()};
+        latency += std::uniform_int_distribution<uint32_t>(0, m_jitter)(random);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(latency));
+}
+
+Account MemoryAccountStore::getAccount(const std::string& email, const std::string& password)
+{
+    TraceSpan span("db.getAccount");
+    Account account;
+    simulateLatency();
+    if (!g_faultInjector.inject(FaultTarget::Database)) {
+        return account;
+    }
+
+    auto it = m_accounts.find(email);
+    if (it == m_accounts.end()) {
+        return account;
+    }
+
+    const AccountEntry& entry = it->second;
+    if (entry.password != (entry.plain ? password : hashPassword(password))) {
+        return account;
+    }
+
+    account.email = email;
+    account.password = password;
+    account.id = entry.id;
+    account.premiumEnd = entry.premiumEnd;
+    return account;
+}
+
+std::vector<Character> MemoryAccountStore::getCharacterList(uint16_t accountId)
+{
+    simulateLatency();
+    if (!g_faultInjector.inject(FaultTarget::Database)) {
+        return {};
+    }
+
+    auto it = m_characters.find(accountId);
+    if (it == m_characters.end()) {
+        return {};
+    }
+    return it->second;
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <database/mysqlaccountstore.h>
+#include <database/database.h>
+#include <core/tracer.h>
+
+Account MySQLAccountStore::getAccount(const std::string& email, const std::string& password)
+{
+    TraceSpan span("db.getAccount");
+    Account account;
+
+    auto accountInfo = getAccountInfo(email, password);
+    if (!accountInfo) {
+        return account;
+    }
+
+    account.email = email;
+    account.password = password;
+    account.id = accountInfo->getNumber<uint16_t>("id");
+    account.premiumEnd = accountInfo->getNumber<uint64_t>("premium_ends_at");
+
+    return account;
+}
+
+DBResultSharedPtr MySQLAccountStore::getAccountInfo(const std::string& email, const std::string& password)
+{
+    std::string hashPass = hashPassword(password);
+    auto result = g_database.storeQuery("SELECT `id`, `email`, `password`, `premium_ends_at` FROM `accounts` WHERE `email` = " + g_database.escapeString(email) + " AND password = " + g_database.escapeString(hashPass));
+    return result;
+}
+
+std::vector<Character> MySQLAccountStore::getCharacterList(uint16_t accountId)
+{
+    std::vector<Character> characters;
+
+    static const DBBinding<Character> binding = DBBinding<Character>()
+        .bind("name", &Character::name)
+        .bind("instance_name", &Character::instanceName)
+        .bind("instance_id", &Character::instanceId)
+        .bind("level", &Character::level)
+        .bind("auto_reconnect", &Character::autoReconnect);
+
+    auto result = g_database.storeQuery("SELECT `name`, `account_id`, `level`, `instance_id`, `instance_name`, `auto_reconnect` FROM `players` WHERE `account_id` = '" + std::to_string(accountId) + "'");
+    if (result) {
+        characters = binding.readAll(*result);
+    }
+    return characters;
+}
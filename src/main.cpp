@@ -8,16 +8,35 @@
 #include "includes.h"
 #include "definitions.h"
 
+#include <fmt/format.h>
+
 #include <core/server.h>
 #include <core/logger.h>
 #include <core/signals.h>
 #include <core/modulemanager.h>
+#include <core/metrics.h>
+#include <core/httpserver.h>
+#include <core/tracer.h>
+#include <core/flightrecorder.h>
+#include <core/faultinjector.h>
+#include <network/characterlistcache.h>
+#include <core/tasks.h>
 
 #include <redis/redis.h>
 
+#include <script/lua.h>
+
+#include <network/opcodehandlers.h>
+
 #include <utils/rsa.h>
 
 #include <database/database.h>
+#include <database/databasetasks.h>
+#include <database/mysqlaccountstore.h>
+#include <database/memoryaccountstore.h>
+
+#include <network/connectionmanager.h>
+#include <network/trafficrecorder.h>
 
 [[noreturn]] void badAllocationHandler() {
     // Use functions that only use stack allocation
@@ -27,11 +46,21 @@
 }
 
 bool mainLoader();
+bool scriptLoader(int argc, char* argv[]);
+bool loadAccountStore();
+void startLogger();
+void setupFaultInjection();
+void startHttpServer();
 
 int main(int argc, char* argv[]) {
     // Setup bad allocation handler
     std::set_new_handler(badAllocationHandler);
 
+    // ./loginserver --script <file> [args...]
+    if (argc > 2 && std::string(argv[1]) == "--script") {
+        return scriptLoader(argc, argv) ? 0 : 1;
+    }
+
     if (mainLoader()) {
         std::string host = g_config->get<std::string>("host");
         int port = g_config->get<int>("port");
@@ -78,22 +107,264 @@ bool mainLoader() {
     if (!g_lua->init())
         return false;
 
+    startLogger();
+    setupFaultInjection();
+
+    if (!loadAccountStore())
+        return false;
+
+    g_characterListCache.setup(g_config->get<uint32_t>("characterListCacheSize", 0), g_config->get<uint32_t>("characterListCacheTtl", 300),
+        g_config->get<std::string>("characterListCacheChannel", "character_list"));
+
+    g_logger.info("Loading redis");
+    if (!g_redis->connect())
+        return false;
+
+    g_logger.info("Loading modules");
+	if (!g_modules->loadModules())
+        return false;
+
+    g_opcodeHandlers.init();
+
+    g_flightRecorder.setup(g_config->get<uint32_t>("slowLoginThreshold", 0), g_config->get<uint32_t>("slowLoginRecords", 256));
+    g_tracer.setup(g_config->get<uint32_t>("traceSampleRate", 0), g_config->get<uint32_t>("traceBufferSize", 16384));
+
+    if (g_config->get<bool>("trafficRecord", false)) {
+        g_trafficRecorder.start(g_config->get<std::string>("trafficRecordDirectory", "recordings"));
+    }
+
+    startHttpServer();
+
+    return true;
+}
+
+bool loadAccountStore() {
+    const std::string type = g_config->get<std::string>("accountStore", "mysql");
+    if (type == "memory") {
+        // no MySQL at all, db.query in the modules fails
+        const std::string file = g_config->get<std::string>("accountStoreFile", "");
+        g_logger.info("Loading accounts from {:s}", file);
+
+        auto store = std::make_shared<MemoryAccountStore>();
+        try {
+            store->load(file);
+        } catch (const std::exception& e) {
+            g_logger.error("Failed to load accounts: {:s}", e.what());
+            return false;
+        }
+        store->setLatency(g_config->get<uint32_t>("accountStoreLatency", 0), g_config->get<uint32_t>("accountStoreLatencyJitter", 0));
+
+        g_logger.info("Loaded {:d} accounts", store->getAccountCount());
+        g_accountStore = std::move(store);
+        return true;
+    }
+
+    if (type != "mysql") {
+        g_logger.error("Unknown accountStore {:s}", type);
+        return false;
+    }
+
     g_logger.info("Establishing database connection...");
     try {
         g_database.connect();
-        g_logger.info("MySQL " + g_database.getVersion());
+        g_logger.info("MySQL {:s}", g_database.getVersion());
+        g_databaseTasks.start();
     } catch (const std::exception& e) {
-        g_logger.error("Failed to connect to database: " + std::string(e.what()));
+        g_logger.error("Failed to connect to database: {:s}", e.what());
         return false;
     }
 
-    g_logger.info("Loading redis");
-    if (!g_redis->connect())
+    g_accountStore = std::make_shared<MySQLAccountStore>();
+    return true;
+}
+
+void startLogger() {
+    SeveretyLevel level;
+    const std::string levelName = g_config->get<std::string>("logLevel", "trace");
+    if (Logger::parseLevel(levelName, level)) {
+        g_logger.setLevel(level);
+    } else {
+        g_logger.warning("Unknown logLevel " + levelName);
+    }
+
+    g_logger.setRepeatLimit(g_config->get<double>("logRepeatRate", 0), g_config->get<double>("logRepeatBurst", 20));
+    g_logger.setOverflow(g_config->get<std::string>("logOverflow", "drop") == "block" ? Logger::Overflow::Block : Logger::Overflow::Drop);
+    g_logger.setFile(g_config->get<std::string>("logFile", ""), g_config->get<size_t>("logMaxFileSize", 16) * 1024 * 1024, g_config->get<uint32_t>("logMaxFiles", 5));
+    g_logger.start();
+}
+
+void setupFaultInjection() {
+    static const std::pair<FaultTarget, const char*> keys[] = {
+        {FaultTarget::Database, "faultDatabase"},
+        {FaultTarget::RedisPublish, "faultRedisPublish"},
+        {FaultTarget::RedisDelivery, "faultRedisDelivery"},
+    };
+
+    for (const auto& [target, key] : keys) {
+        const std::string spec = g_config->get<std::string>(key, "");
+        if (spec.empty()) {
+            continue;
+        }
+
+        FaultInjector::Profile profile;
+        std::string error;
+        if (!FaultInjector::parseProfile(spec, profile, error)) {
+            g_logger.warning("Invalid {:s}: {:s}", key, error);
+            continue;
+        }
+
+        g_faultInjector.setProfile(target, profile);
+        g_logger.warning("Fault injection on {:s}: {:s}", FaultInjector::getTargetName(target), spec);
+    }
+}
+
+void startHttpServer() {
+    int port = g_config->get<int>("metricsPort", 0);
+    if (port == 0) {
+        return;
+    }
+
+    g_metrics.addCallbackGauge("loginserver_connections_active", "Open client connections.", []() {
+        return static_cast<double>(g_connectionManager.getConnectionCount());
+    });
+    g_metrics.addCallbackGauge("loginserver_dispatcher_queue_depth", "Tasks waiting in the dispatcher queue.", []() {
+        return static_cast<double>(g_dispatcher.getQueueSize());
+    });
+    g_metrics.addCallbackCounter("loginserver_dispatcher_tasks_total", "Tasks executed by the dispatcher.", []() {
+        return static_cast<double>(g_dispatcher.getDispatcherCycle());
+    });
+
+    g_metrics.addCallbackCounter("loginserver_log_messages_total", "Log messages written.", []() {
+        return static_cast<double>(g_logger.getWritten());
+    });
+    g_metrics.addCallbackCounter("loginserver_log_dropped_total", "Log messages dropped because a log ring was full.", []() {
+        return static_cast<double>(g_logger.getDropped());
+    });
+
+    g_metrics.addCallbackCounter("loginserver_faults_errors_total", "Calls failed by the fault injection.", []() {
+        return static_cast<double>(g_faultInjector.getErrors());
+    });
+    g_metrics.addCallbackCounter("loginserver_faults_stalls_total", "Calls stalled by the fault injection.", []() {
+        return static_cast<double>(g_faultInjector.getStalls());
+    });
+
+    g_metrics.addCallbackCounter("loginserver_character_list_cache_hits_total", "Logins that found their character list in the cache.", []() {
+        return static_cast<double>(g_characterListCache.getHits());
+    });
+    g_metrics.addCallbackCounter("loginserver_character_list_cache_misses_total", "Logins that read their character list from the account store.", []() {
+        return static_cast<double>(g_characterListCache.getMisses());
+    });
+    g_metrics.addCallbackCounter("loginserver_character_list_cache_invalidations_total", "Invalidation messages applied to the character list cache.", []() {
+        return static_cast<double>(g_characterListCache.getInvalidations());
+    });
+
+    g_httpServer.addRoute("/metrics", [](const HttpRequest&) {
+        return HttpResponse{200, "text/plain; version=0.0.4; charset=utf-8", g_metrics.render()};
+    });
+
+    // /loglevel[?level=trace|debug|info|warning|error|fatal]
+    g_httpServer.addRoute("/loglevel", [](const HttpRequest& request) {
+        auto it = request.query.find("level");
+        if (it != request.query.end()) {
+            SeveretyLevel level;
+            if (!Logger::parseLevel(it->second, level)) {
+                return HttpResponse{400, "text/plain; charset=utf-8", "unknown level\n"};
+            }
+            g_logger.setLevel(level);
+            g_logger.info("[Logger] Level set to {:s}", Logger::getLevelName(level));
+        }
+        return HttpResponse{200, "text/plain; charset=utf-8", std::string(Logger::getLevelName(g_logger.getLevel())) + "\n"};
+    });
+
+    g_httpServer.addRoute("/slowlogins", [](const HttpRequest&) {
+        if (!g_flightRecorder.isEnabled()) {
+            return HttpResponse{503, "text/plain; charset=utf-8", "slow login recorder disabled, set slowLoginThreshold\n"};
+        }
+        return HttpResponse{200, "text/plain; charset=utf-8", g_flightRecorder.dump()};
+    });
+
+    // /trace[?clear=1], open in ui.perfetto.dev or chrome://tracing
+    g_httpServer.addRoute("/trace", [](const HttpRequest& request) {
+        if (!g_tracer.isEnabled()) {
+            return HttpResponse{503, "text/plain; charset=utf-8", "tracing disabled, set traceSampleRate\n"};
+        }
+
+        HttpResponse response{200, "application/json", g_tracer.dump()};
+        if (request.query.count("clear")) {
+            g_tracer.clear();
+        }
+        return response;
+    });
+
+    // /faults[?target=database|redisPublish|redisDelivery&latency=..&distribution=..&errors=..&stalls=..&stall=..|&clear=1]
+    g_httpServer.addRoute("/faults", [](const HttpRequest& request) {
+        auto targetIt = request.query.find("target");
+        if (targetIt != request.query.end()) {
+            FaultTarget target;
+            if (!FaultInjector::parseTarget(targetIt->second, target)) {
+                return HttpResponse{400, "text/plain; charset=utf-8", "unknown target\n"};
+            }
+
+            FaultInjector::Profile profile;
+            if (!request.query.count("clear")) {
+                profile = g_faultInjector.getProfile(target);
+
+                std::string spec;
+                for (const auto& [key, value] : request.query) {
+                    if (key != "target") {
+                        spec += key + "=" + value + ",";
+                    }
+                }
+
+                std::string error;
+                if (!FaultInjector::parseProfile(spec, profile, error)) {
+                    return HttpResponse{400, "text/plain; charset=utf-8", error + "\n"};
+                }
+            }
+
+            g_faultInjector.setProfile(target, profile);
+            g_logger.warning("[FaultInjector] {:s} changed on the admin port", FaultInjector::getTargetName(target));
+        }
+        return HttpResponse{200, "text/plain; charset=utf-8", g_faultInjector.dump()};
+    });
+
+    // /record[?start=1|?stop=1], files go to trafficRecordDirectory
+    g_httpServer.addRoute("/record", [](const HttpRequest& request) {
+        if (request.query.count("start") && !g_trafficRecorder.start(g_config->get<std::string>("trafficRecordDirectory", "recordings"))) {
+            return HttpResponse{409, "text/plain; charset=utf-8", "already recording or the file could not be created\n"};
+        }
+        if (request.query.count("stop")) {
+            g_trafficRecorder.stop();
+        }
+        return HttpResponse{200, "text/plain; charset=utf-8", g_trafficRecorder.getStatus()};
+    });
+
+    if (g_httpServer.open(g_config->get<std::string>("metricsHost", "127.0.0.1"), port)) {
+        g_httpServer.start();
+    }
+}
+
+bool scriptLoader(int argc, char* argv[]) {
+    // Runs a standalone script (e.g. bench/lua) with the lua bindings but
+    // without database, redis or modules.
+    g_logger.info("Loading lua");
+    if (!g_lua->init())
         return false;
 
-    g_logger.info("Loading modules");
-	if (!g_modules->loadModules())
+    lua_State* L = g_lua->getLuaState();
+    lua_createtable(L, argc - 3, 0);
+    for (int i = 3; i < argc; ++i) {
+        LuaScript::pushString(L, argv[i]);
+        lua_rawseti(L, -2, i - 2);
+    }
+    lua_setglobal(L, "SCRIPT_ARGS");
+
+    const std::string file = argv[2];
+    if (g_lua->loadFile(file) == -1) {
+        g_logger.error("Failed to run " + file);
+        g_logger.trace(g_lua->getLastLuaError());
         return false;
+    }
 
     return true;
 }
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <charconv>
+
+#include <network/characterlistcache.h>
+#include <network/packets.h>
+
+#include <core/logger.h>
+
+CharacterListCache g_characterListCache;
+
+void CharacterListCache::setup(size_t capacity, uint32_t ttl, const std::string& channel)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    m_ttl = std::chrono::seconds(ttl);
+    m_channel = channel;
+    m_entries.clear();
+    m_entries.reserve(capacity);
+    m_order.clear();
+}
+
+CharacterListCache::Entry& CharacterListCache::getEntry(uint16_t accountId)
+{
+    auto it = m_entries.find(accountId);
+    if (it != m_entries.end()) {
+        m_order.splice(m_order.begin(), m_order, it->second.position);
+        return it->second;
+    }
+
+    if (m_entries.size() >= m_capacity) {
+        m_entries.erase(m_order.back());
+        m_order.pop_back();
+    }
+
+    m_order.push_front(accountId);
+    return m_entries.emplace(accountId, Entry{nullptr, ++m_version, {}, m_order.begin()}).first->second;
+}
+
+CharacterListCache::Payload CharacterListCache::get(uint16_t accountId, uint64_t& version)
+{
+    if (!isEnabled()) {
+        version = 0;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = getEntry(accountId);
+    version = entry.version;
+
+    if (entry.payload && entry.expires > std::chrono::steady_clock::now()) {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return entry.payload;
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void CharacterListCache::put(uint16_t accountId, uint64_t version, Payload payload)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(accountId);
+    // invalidated or evicted while the list was loaded
+    if (it == m_entries.end() || it->second.version != version) {
+        return;
+    }
+
+    it->second.payload = std::move(payload);
+    it->second.expires = std::chrono::steady_clock::now() + m_ttl;
+}
+
+void CharacterListCache::discard(uint16_t accountId, uint64_t version)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // a newer version belongs to another load or an invalidation
+    auto it = m_entries.find(accountId);
+    if (it == m_entries.end() || it->second.version != version || it->second.payload) {
+        return;
+    }
+
+    m_order.erase(it->second.position);
+    m_entries.erase(it);
+}
+
+void CharacterListCache::invalidate(uint16_t accountId)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // a load in flight created the entry in get(), nothing to do without one
+    auto it = m_entries.find(accountId);
+    if (it != m_entries.end()) {
+        it->second.payload = nullptr;
+        it->second.version = ++m_version;
+    }
+    m_invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CharacterListCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // loads in flight still hold a version of a dropped entry, put() ignores them
+    m_entries.clear();
+    m_order.clear();
+    m_invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CharacterListCache::handleMessage(const std::string& message)
+{
+    if (message == "*") {
+        clear();
+        return;
+    }
+
+    uint32_t accountId = 0;
+    auto [end, error] = std::from_chars(message.data(), message.data() + message.size(), accountId);
+    if (error != std::errc() || end != message.data() + message.size() || accountId > std::numeric_limits<uint16_t>::max()) {
+        g_logger.warning("[CharacterListCache] Invalid message on {:s}: {:s}", m_channel, message);
+        return;
+    }
+
+    invalidate(static_cast<uint16_t>(accountId));
+}
+
+CharacterListCache::Payload CharacterListCache::serialize(const std::vector<Character>& characters)
+{
+    Packets::CharacterListCharacters::Type values;
+    values.reserve(characters.size());
+    for (const auto& character : characters) {
+        values.emplace_back(character.name, character.instanceName, character.instanceId, character.level, static_cast<uint8_t>(character.autoReconnect));
+    }
+
+    auto payload = std::make_shared<std::string>(Packets::CharacterListCharacters::size(values), '\0');
+    uint8_t* out = reinterpret_cast<uint8_t*>(payload->data());
+    Packets::CharacterListCharacters::write(out, values);
+    return payload;
+}
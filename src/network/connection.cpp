@@ -11,9 +11,12 @@
 #include <network/connectionmanager.h>
 #include <network/outputmessage.h>
 #include <network/protocol.h>
+#include <network/trafficrecorder.h>
 
 #include <core/server.h>
 #include <core/logger.h>
+#include <core/metrics.h>
+#include <core/tracer.h>
 
 void Connection::close()
 {
@@ -24,6 +27,11 @@ void Connection::close()
         return;
 
     m_closed = true;
+    g_trafficRecorder.recordClose(m_id);
+
+    if (m_traceId != 0) {
+        g_tracer.recordAsync(m_traceId, "connection", m_acceptTime, Tracer::now());
+    }
 
     closeSocket();
 }
@@ -38,7 +46,7 @@ void Connection::closeSocket()
             m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
             m_socket.close(error);
         } catch (boost::system::system_error& e) {
-            g_logger.error("Network error: " + std::string(e.what()));
+            g_logger.error("Network error: {:s}", e.what());
         }
     }
 }
@@ -53,6 +61,11 @@ void Connection::accept()
     m_protocol = std::make_shared<Protocol>(shared_from_this());
 
     std::lock_guard<std::recursive_mutex> lockClass(m_connectionLock);
+    m_traceId = g_tracer.sample();
+    if (m_traceId != 0) {
+        m_acceptTime = m_readStart = Tracer::now();
+    }
+
     try {
         m_readTimer.expires_from_now(boost::posix_time::seconds(CONNECTION_READ_TIMEOUT));
         m_readTimer.async_wait(std::bind(&Connection::handleTimeout, std::weak_ptr<Connection>(shared_from_this()), std::placeholders::_1));
@@ -62,7 +75,7 @@ void Connection::accept()
                                 boost::asio::buffer(m_msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
                                 std::bind(&Connection::parseHeader, shared_from_this(), std::placeholders::_1));
     } catch (boost::system::system_error& e) {
-        g_logger.error("Network error: " + std::string(e.what()));
+        g_logger.error("Network error: {:s}", e.what());
         close();
     }
 }
@@ -72,6 +85,13 @@ void Connection::parseHeader(const boost::system::error_code& error)
     std::lock_guard<std::recursive_mutex> lockClass(m_connectionLock);
     m_readTimer.cancel();
 
+    TraceContext traceContext(m_traceId);
+    if (m_traceId != 0) {
+        g_tracer.recordAsync(m_traceId, "net.readHeader", m_readStart, Tracer::now());
+        m_readStart = Tracer::now();
+    }
+    TraceSpan span("parseHeader");
+
     if (error) {
         close();
         return;
@@ -93,7 +113,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
         boost::asio::async_read(m_socket, boost::asio::buffer(m_msg.getBodyBuffer(), size),
                                 std::bind(&Connection::parsePacket, shared_from_this(), std::placeholders::_1));
     } catch (boost::system::system_error& e) {
-        g_logger.error("Network error: " + std::string(e.what()));
+        g_logger.error("Network error: {:s}", e.what());
         close();
     }
 }
@@ -110,6 +130,14 @@ void Connection::parsePacket(const boost::system::error_code& error)
         return;
     }
 
+    TraceContext traceContext(m_traceId);
+    if (m_traceId != 0) {
+        g_tracer.recordAsync(m_traceId, "net.readBody", m_readStart, Tracer::now());
+    }
+    TraceSpan span("parsePacket");
+
+    g_metrics.bytesReceived.inc(m_msg.getLength());
+
     //Check packet checksum
     uint32_t checksum;
     int32_t len = m_msg.getLength() - m_msg.getBufferPosition() - NetworkMessage::CHECKSUM_LENGTH;
@@ -139,10 +167,11 @@ void Connection::parsePacket(const boost::system::error_code& error)
             std::placeholders::_1));
 
         // Wait to the next packet
+        m_readStart = m_traceId != 0 ? Tracer::now() : 0;
         boost::asio::async_read(m_socket, boost::asio::buffer(m_msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
             std::bind(&Connection::parseHeader, shared_from_this(), std::placeholders::_1));
 	} catch (boost::system::system_error& e) {
-        g_logger.error("Network error: " + std::string(e.what()));
+        g_logger.error("Network error: {:s}", e.what());
         close();
 	}
 }
@@ -155,17 +184,22 @@ void Connection::send(OutputMessage& msg)
 
 void Connection::internalSend(OutputMessage& msg)
 {
+    TraceContext traceContext(m_traceId);
+    TraceSpan span("send");
+
     m_protocol->encryptMessage(msg);
+    g_metrics.bytesSent.inc(msg.getLength());
     try {
         m_writeTimer.expires_from_now(boost::posix_time::seconds(CONNECTION_WRITE_TIMEOUT));
         m_writeTimer.async_wait(std::bind(&Connection::handleTimeout, std::weak_ptr<Connection>(shared_from_this()),
             std::placeholders::_1));
 
+        m_writeStart = m_traceId != 0 ? Tracer::now() : 0;
         boost::asio::async_write(m_socket,
             boost::asio::buffer(msg.getOutputBuffer(), msg.getLength()),
             std::bind(&Connection::onWriteOperation, shared_from_this(), std::placeholders::_1));
     } catch (boost::system::system_error& e) {
-        g_logger.error("Network error: " + std::string(e.what()));
+        g_logger.error("Network error: {:s}", e.what());
         close();
     }
 }
@@ -195,6 +229,10 @@ void Connection::onWriteOperation(const boost::system::error_code& error)
     std::lock_guard<std::recursive_mutex> lockClass(m_connectionLock);
     m_writeTimer.cancel();
 
+    if (m_traceId != 0) {
+        g_tracer.recordAsync(m_traceId, "net.write", m_writeStart, Tracer::now());
+    }
+
     if (error) {
         close();
         return;
@@ -44,6 +44,12 @@ void ConnectionManager::closeAll()
     m_connections.clear();
 }
 
+size_t ConnectionManager::getConnectionCount()
+{
+    std::lock_guard<std::mutex> lockClass(m_connectionManagerLock);
+    return m_connections.size();
+}
+
 ProtocolSharedPtr ConnectionManager::getProtocolById(uint64_t id)
 {
     for (ConnectionSharedPtr connection : m_connections) {
@@ -16,22 +16,38 @@ int32_t NetworkMessage::decodeHeader()
     return m_info.length;
 }
 
+NetworkMessage::Layout NetworkMessage::getLayout()
+{
+    const size_t info = offsetof(NetworkMessage, m_info);
+    return Layout {
+        info + offsetof(NetworkMessageInfo, length),
+        info + offsetof(NetworkMessageInfo, position),
+        info + offsetof(NetworkMessageInfo, overrun),
+        offsetof(NetworkMessage, m_buffer)
+    };
+}
+
 std::string NetworkMessage::getString(uint16_t stringLen/* = 0*/)
+{
+    return std::string(getStringView(stringLen));
+}
+
+std::string_view NetworkMessage::getStringView(uint16_t stringLen/* = 0*/)
 {
     if (stringLen == 0) {
         stringLen = get<uint16_t>();
     }
 
     if (!canRead(stringLen)) {
-        return std::string();
+        return std::string_view();
     }
 
-    char* v = reinterpret_cast<char*>(m_buffer) + m_info.position; //does not break strict aliasing
+    const char* v = reinterpret_cast<const char*>(m_buffer) + m_info.position; //does not break strict aliasing
     m_info.position += stringLen;
-    return std::string(v, stringLen);
+    return std::string_view(v, stringLen);
 }
 
-void NetworkMessage::addString(const std::string& value)
+void NetworkMessage::addString(std::string_view value)
 {
     size_t stringLen = value.length();
     if (!canAdd(stringLen + 2) || stringLen > 8192) {
@@ -39,7 +55,7 @@ void NetworkMessage::addString(const std::string& value)
     }
 
     add<uint16_t>(stringLen);
-    memcpy(m_buffer + m_info.position, value.c_str(), stringLen);
+    memcpy(m_buffer + m_info.position, value.data(), stringLen);
     m_info.position += stringLen;
     m_info.length += stringLen;
 }
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <network/opcodehandlers.h>
+#include <network/connectionmanager.h>
+#include <network/outputmessage.h>
+#include <network/packets.h>
+
+#include <redis/requests.h>
+
+#include <core/logger.h>
+
+#include <script/lua.h>
+
+OpcodeHandlers g_opcodeHandlers;
+
+// Native version of modules/login/login_main.lua, asks the central for the
+// game server of the instance and forwards its address to the client
+static void parseGameServerHost(const ProtocolSharedPtr& protocol, NetworkMessage& msg)
+{
+    Packets::GameServerHostRequest::Values request;
+    if (!Packets::GameServerHostRequest::decode(msg, request)) {
+        return;
+    }
+
+    auto& [instanceName, instanceId] = request;
+    const uint64_t clientId = protocol->getId();
+
+    g_redisRequests.request("central_login", {
+        {"action", "game-server-host"},
+        {"instanceName", std::string(instanceName)},
+        {"instanceId", std::string(instanceId)}
+    }, [clientId](const RedisRequests::Answer& result) {
+        if (result.timedOut) {
+            return;
+        }
+
+        ProtocolSharedPtr client = g_connectionManager.getProtocolById(clientId);
+        if (!client) {
+            return;
+        }
+
+        const JsonFields& answer = result.fields;
+        auto host = answer.find("host");
+        auto port = answer.find("port");
+        // same check as login_main.lua: not answer.success
+        if (!isJsonTruthy(answer, "success") || host == answer.end() || port == answer.end()) {
+            return;
+        }
+
+        OutputMessage output;
+        Packets::GameServerHost::encode(output, {host->second, static_cast<uint16_t>(std::strtoul(port->second.c_str(), nullptr, 10))});
+        client->send(output);
+    });
+}
+
+void OpcodeHandlers::init()
+{
+    registerHandler(Opcode::GameServerHost, "GameServerHost", parseGameServerHost);
+
+    lua_State* L = g_lua->getLuaState();
+    g_config->putInStack();
+    lua_getfield(L, -1, "luaOpcodes");
+    LuaTable luaOpcodes(L);
+    lua_pop(L, 2);
+
+    luaOpcodes.forEach<uint8_t>([this](uint8_t opcode) {
+        removeHandler(opcode);
+    });
+}
+
+void OpcodeHandlers::registerHandler(uint8_t opcode, const std::string& name, Handler handler)
+{
+    m_handlers[opcode] = std::move(handler);
+    m_names[opcode] = name;
+}
+
+void OpcodeHandlers::removeHandler(uint8_t opcode)
+{
+    if (!m_handlers[opcode]) {
+        return;
+    }
+
+    g_logger.info("Opcode {:d} ({:s}) handled by the Lua modules", opcode, m_names[opcode]);
+    m_handlers[opcode] = nullptr;
+    m_names[opcode].clear();
+}
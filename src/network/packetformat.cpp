@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <network/packetformat.h>
+
+const PacketFormat* PacketFormat::get(const std::string& pattern)
+{
+    static std::mutex cacheLock;
+    static std::unordered_map<std::string, std::unique_ptr<PacketFormat>> cache;
+
+    std::lock_guard<std::mutex> lockClass(cacheLock);
+
+    auto it = cache.find(pattern);
+    if (it != cache.end()) {
+        return it->second.get();
+    }
+
+    auto format = std::make_unique<PacketFormat>();
+    if (!format->compile(pattern)) {
+        format.reset();
+    }
+
+    return cache.emplace(pattern, std::move(format)).first->second.get();
+}
+
+bool PacketFormat::compile(const std::string& pattern)
+{
+    std::istringstream stream(pattern);
+    std::string token;
+
+    while (stream >> token) {
+        if (m_fields.size() >= MAX_FIELDS) {
+            return false;
+        }
+
+        if (token == "u8") {
+            m_fields.push_back(FieldType::U8);
+        } else if (token == "u16") {
+            m_fields.push_back(FieldType::U16);
+        } else if (token == "u32") {
+            m_fields.push_back(FieldType::U32);
+        } else if (token == "u64") {
+            m_fields.push_back(FieldType::U64);
+        } else if (token == "s") {
+            m_fields.push_back(FieldType::String);
+        } else {
+            return false;
+        }
+    }
+
+    return !m_fields.empty();
+}
@@ -9,14 +9,20 @@
 
 #include <network/protocol.h>
 #include <network/outputmessage.h>
+#include <network/packets.h>
+#include <network/opcodehandlers.h>
+#include <network/trafficrecorder.h>
 
 #include <utils/rsa.h>
 #include <utils/xtea.h>
 
-#include <database/database.h>
+#include <database/accountstore.h>
 
 #include <core/logger.h>
 #include <core/modulemanager.h>
+#include <core/metrics.h>
+#include <core/tracer.h>
+#include <core/flightrecorder.h>
 
 #include <script/lua.h>
 
@@ -24,104 +30,181 @@
 
 void Protocol::addMOTD(OutputMessage& msg)
 {
-    msg.addByte(Opcode::Motd);
     std::ostringstream ss;
     ss << g_config->get<int>("motdNumber", 0) << "\n";
     ss << g_config->get<std::string>("motdMessage");
-    msg.addString(ss.str());
+    Packets::Motd::encode(msg, {ss.str()});
 }
 
 void Protocol::addSessionKey(OutputMessage& msg)
 {
     uint32_t ticks = time(nullptr) / AUTHENTICATOR_PERIOD;
-    msg.addByte(Opcode::SessionKey);
-    msg.addString(m_account.email + "\n" + m_account.password + "\n\n" + std::to_string(ticks));
+    Packets::SessionKey::encode(msg, {m_account.email + "\n" + m_account.password + "\n\n" + std::to_string(ticks)});
 }
 
-void Protocol::addCharacterList(OutputMessage& msg)
+void Protocol::addCharacterList(OutputMessage& msg, const std::string& characters)
 {
-    msg.addByte(Opcode::CharacterList);
-
-    auto characters = m_account.characters;
-    msg.addByte(characters.size()); // number of chars
-    for (auto character : characters) {
-        msg.addString(character.name);
-        msg.addString(character.instanceName);
-        msg.addString(character.instanceId);
-        msg.add<uint16_t>(character.level);
-        msg.add<uint8_t>(static_cast<uint8_t>(character.autoReconnect));
+    // same bytes as Packets::CharacterList, the characters are serialized already
+    uint8_t* out = msg.reserveBytes(1 + characters.size());
+    if (!out) {
+        return;
     }
 
+    *out++ = Opcode::CharacterList;
+    memcpy(out, characters.data(), characters.size());
+
     //Add premium days
-    msg.addByte(0);
-    msg.addByte(m_account.premiumEnd > static_cast<uint64_t>(time(nullptr)) ? 1 : 0);
-    msg.add<uint32_t>(m_account.premiumEnd);
+    Packets::CharacterListPremium::Values values;
+    auto& [reserved, premium, premiumEnd] = values;
+    reserved = 0;
+    premium = m_account.premiumEnd > static_cast<uint64_t>(time(nullptr)) ? 1 : 0;
+    premiumEnd = m_account.premiumEnd;
+
+    Packets::CharacterListPremium::encode(msg, values);
+}
+
+CharacterListCache::Payload Protocol::loadCharacterList(uint32_t& dbRows)
+{
+    uint64_t version;
+    CharacterListCache::Payload payload = g_characterListCache.get(m_account.id, version);
+    if (payload) {
+        return payload;
+    }
+
+    std::vector<Character> characters = g_accountStore->getCharacterList(m_account.id);
+    dbRows = static_cast<uint32_t>(characters.size());
+
+    payload = CharacterListCache::serialize(characters);
+    // a failed query looks like an account without characters, neither is kept
+    if (!characters.empty()) {
+        g_characterListCache.put(m_account.id, version, payload);
+    } else {
+        g_characterListCache.discard(m_account.id, version);
+    }
+    return payload;
 }
 
 void Protocol::authenticate(NetworkMessage& msg)
 {
-    msg.skipBytes(2); // operating system
+    LoginTimer loginTimer;
+    if (g_flightRecorder.isEnabled()) {
+        if (ConnectionSharedPtr connection = getConnection()) {
+            loginTimer.setIp(connection->getIP());
+        }
+    }
+
+    Packets::LoginHeader::Values header;
+    if (!Packets::LoginHeader::decode(msg, header)) {
+        g_metrics.loginsRejected.inc();
+        loginTimer.finish(FlightRecorder::Rejected);
+        disconnect();
+        return;
+    }
+
+    auto& [operatingSystem, version, signatures] = header;
+    loginTimer.stage(LoginStage::Decode);
 
-    uint16_t version = msg.get<uint16_t>();
+    bool decrypted;
+    {
+        MetricTimer rsaTimer(g_metrics.rsaDecryptTime);
+        TraceSpan span("rsa.decrypt");
+        decrypted = g_RSA.decrypt(msg);
+    }
+    loginTimer.stage(LoginStage::RsaDecrypt);
 
-    msg.skipBytes(17);
-    /*
-     * Skipped bytes:
-     * 4 bytes: protocolVersion
-     * 12 bytes: dat, spr, pic signatures (4 bytes each)
-     * 1 byte: 0
-     */
+    if (!decrypted) {
+        g_metrics.loginsRejected.inc();
+        loginTimer.finish(FlightRecorder::Rejected);
+        disconnect();
+        return;
+    }
 
-    if (!g_RSA.decrypt(msg)) {
+    Packets::LoginCredentials::Values credentials;
+    if (!Packets::LoginCredentials::decode(msg, credentials)) {
+        g_metrics.loginsRejected.inc();
+        loginTimer.finish(FlightRecorder::Rejected);
         disconnect();
         return;
     }
 
-    uint32_t key[4];
-    key[0] = msg.get<uint32_t>();
-    key[1] = msg.get<uint32_t>();
-    key[2] = msg.get<uint32_t>();
-    key[3] = msg.get<uint32_t>();
-    setXTEAKey(key);
+    auto& [key, email, password] = credentials;
+    setXTEAKey(key.data());
+
+    if (g_trafficRecorder.isRecording()) {
+        if (ConnectionSharedPtr connection = getConnection()) {
+            g_trafficRecorder.recordLogin(connection->getId(), version, key, email);
+        }
+    }
 
     uint16_t versionMin = g_config->get<uint16_t>("versionMin");
     if (version < versionMin) {
         std::string versionStr = g_config->get<std::string>("versionStr");
+        g_metrics.loginsRejected.inc();
+        loginTimer.finish(FlightRecorder::Rejected);
         disconnectClient("Only clients with protocol " + versionStr + " allowed!");
         return;
     }
 
-    std::string email = msg.getString();
     if (email.empty()) {
+        g_metrics.loginsRejected.inc();
+        loginTimer.finish(FlightRecorder::Rejected);
         disconnectClient("Invalid account email.");
         return;
     }
 
-    std::string password = msg.getString();
     if (password.empty()) {
+        g_metrics.loginsRejected.inc();
+        loginTimer.finish(FlightRecorder::Rejected);
         disconnectClient("Invalid password.");
         return;
     }
 
-    m_account = g_database.getAccount(email, password);
+    loginTimer.stage(LoginStage::Decode);
+
+    m_account = g_accountStore->getAccount(std::string(email), std::string(password));
+
+    CharacterListCache::Payload characters;
+    uint32_t dbRows = 0;
+    if (m_account.id) {
+        characters = loadCharacterList(dbRows);
+    }
+    loginTimer.stage(LoginStage::Database);
+    loginTimer.setAccount(m_account.id, dbRows);
     if (!m_account.id) {
+        g_metrics.loginsFailed.inc();
+        loginTimer.finish(FlightRecorder::Failed);
         disconnectClient("Invalid account email or password.");
         return;
     }
 
     OutputMessage output;
-
-    addMOTD(output);
-    addSessionKey(output);
-    addCharacterList(output);
+    {
+        TraceSpan span("response.build");
+        addMOTD(output);
+        addSessionKey(output);
+        addCharacterList(output, *characters);
+    }
+    loginTimer.stage(LoginStage::BuildResponse);
 
     send(output);
+    loginTimer.stage(LoginStage::Send);
+    g_metrics.loginsSucceeded.inc();
+    loginTimer.finish(FlightRecorder::Ok);
 }
 
 void Protocol::parsePacket(NetworkMessage& msg)
 {
-    if (!g_XTEA.decrypt(m_key, msg))
-        return;
+    {
+        TraceSpan span("xtea.decrypt");
+        if (!g_XTEA.decrypt(m_key, msg))
+            return;
+    }
+
+    if (g_trafficRecorder.isRecording()) {
+        if (ConnectionSharedPtr connection = getConnection()) {
+            g_trafficRecorder.recordPacket(connection->getId(), msg.getBuffer() + msg.getBufferPosition(), msg.getLength());
+        }
+    }
 
     uint8_t opcode = msg.getByte();
     if (opcode == Opcode::Ping) {
@@ -129,22 +212,28 @@ void Protocol::parsePacket(NetworkMessage& msg)
         return;
     }
 
+    {
+        TraceSpan span("opcode.handler");
+        if (g_opcodeHandlers.handle(opcode, shared_from_this(), msg)) {
+            return;
+        }
+    }
+
+    TraceSpan span("lua.emit");
     g_modules->emitNoRet("onReceiveNetworkMessage", std::to_string(opcode), std::tuple{"client", shared_from_this()}, std::tuple{"msg", &msg});
 }
 
 void Protocol::sendError(const std::string& message) const
 {
     OutputMessage msg;
-    msg.addByte(Opcode::Error);
-    msg.addString(message);
+    Packets::Error::encode(msg, {message});
     send(msg);
 }
 
 void Protocol::sendLoadingMessage(const std::string& message) const
 {
     OutputMessage msg;
-    msg.addByte(Opcode::LoadingMessage);
-    msg.addString(message);
+    Packets::LoadingMessage::encode(msg, {message});
     send(msg);
 }
 
@@ -157,6 +246,7 @@ void Protocol::disconnectClient(const std::string& message) const
 void Protocol::encryptMessage(OutputMessage& msg)
 {
     msg.writeMessageLength();
+    TraceSpan span("xtea.encrypt");
     g_XTEA.encrypt(m_key, msg);
     msg.addCryptoHeader();
 }
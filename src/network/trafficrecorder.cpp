@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <network/trafficrecorder.h>
+#include <core/logger.h>
+
+TrafficRecorder g_trafficRecorder;
+
+namespace
+{
+    void addVarint(std::string& buffer, uint64_t value)
+    {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    template<typename T>
+    void addInteger(std::string& buffer, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            buffer.push_back(static_cast<char>(value >> (8 * i)));
+        }
+    }
+}
+
+bool TrafficRecorder::start(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (isRecording()) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    const std::string path = fmt::format("{:s}/recording-{:d}.bin", directory, std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        g_logger.error("[TrafficRecorder] Failed to create {:s}", path);
+        return false;
+    }
+
+    m_file.write("PWOR", 4);
+    m_file.put(static_cast<char>(FORMAT_VERSION));
+
+    m_path = path;
+    m_records = 0;
+    m_last = std::chrono::steady_clock::now();
+    m_recording.store(true, std::memory_order_relaxed);
+
+    g_logger.info("[TrafficRecorder] Recording to {:s}", path);
+    return true;
+}
+
+void TrafficRecorder::stop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isRecording()) {
+        return;
+    }
+
+    m_recording.store(false, std::memory_order_relaxed);
+    m_file.close();
+    g_logger.info("[TrafficRecorder] {:d} records written to {:s}", m_records, m_path);
+}
+
+std::string TrafficRecorder::getStatus()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_path.empty()) {
+        return "not recording\n";
+    }
+    return fmt::format("{:s} {:s}, {:d} records\n", isRecording() ? "recording to" : "recorded", m_path, m_records);
+}
+
+void TrafficRecorder::recordLogin(uint64_t connectionId, uint16_t version, const std::array<uint32_t, 4>& key, std::string_view email)
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    std::string data;
+    addInteger(data, version);
+    for (uint32_t part : key) {
+        addInteger(data, part);
+    }
+    addInteger(data, static_cast<uint16_t>(email.size()));
+    data.append(email);
+    write(Login, connectionId, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+void TrafficRecorder::recordPacket(uint64_t connectionId, const uint8_t* data, size_t size)
+{
+    if (isRecording()) {
+        write(Packet, connectionId, data, size);
+    }
+}
+
+void TrafficRecorder::recordClose(uint64_t connectionId)
+{
+    if (isRecording()) {
+        write(Close, connectionId, nullptr, 0);
+    }
+}
+
+void TrafficRecorder::write(RecordType type, uint64_t connectionId, const uint8_t* data, size_t size)
+{
+    std::string header;
+    header.push_back(static_cast<char>(type));
+    addVarint(header, connectionId);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // stopped while the record was built
+    if (!isRecording()) {
+        return;
+    }
+
+    // taken under the lock so the deltas never go negative
+    const auto now = std::chrono::steady_clock::now();
+    addVarint(header, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - m_last).count()));
+    addVarint(header, size);
+    m_last = now;
+
+    m_file.write(header.data(), header.size());
+    if (size != 0) {
+        m_file.write(reinterpret_cast<const char*>(data), size);
+    }
+    ++m_records;
+
+    if (!m_file) {
+        m_recording.store(false, std::memory_order_relaxed);
+        m_file.close();
+        g_logger.error("[TrafficRecorder] Failed to write {:s}, recording stopped", m_path);
+    }
+}
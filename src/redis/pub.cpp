@@ -9,6 +9,8 @@
 
 #include <redis/pub.h>
 #include <core/logger.h>
+#include <core/metrics.h>
+#include <core/faultinjector.h>
 
 RedisPublisherPtr g_redisPublisher = std::make_shared<RedisPublisher>();
 
@@ -22,7 +24,7 @@ bool RedisPublisher::connect(const std::string& host, int port)
 {
     m_context = redisConnect(host.c_str(), port);
     if (!m_context || m_context->err) {
-        g_logger.fatal(fmt::format("[RedisPublisher] Failed to estabilish connection. address: {:s}:{:d}", host, port));
+        g_logger.fatal("[RedisPublisher] Failed to estabilish connection. address: {:s}:{:d}", host, port);
         return false;
     }
 
@@ -31,12 +33,18 @@ bool RedisPublisher::connect(const std::string& host, int port)
 
 bool RedisPublisher::publish(const std::string& channel, const std::string& data)
 {
+    MetricTimer publishTimer(g_metrics.redisPublishTime);
+    if (!g_faultInjector.inject(FaultTarget::RedisPublish)) {
+        g_logger.error("[RedisPublisher] Injected failure publishing to channel {:s}", channel);
+        return false;
+    }
+
     redisReply* reply = (redisReply*)redisCommand(m_context, "PUBLISH %s %s", channel.c_str(), data.c_str());
     if (reply) {
         freeReplyObject(reply);
         return true;
     } else {
-        g_logger.fatal(fmt::format("[RedisPublisher] Failed to publish to channel {:s} data: {:s}", channel, data.c_str()));
+        g_logger.fatal("[RedisPublisher] Failed to publish to channel {:s} data: {:s}", channel, data.c_str());
     }
 
     return false;
@@ -10,9 +10,13 @@
 #include <redis/redis.h>
 #include <redis/pub.h>
 #include <redis/sub.h>
+#include <redis/requests.h>
 
 #include <core/logger.h>
 #include <core/tasks.h>
+#include <core/scheduler.h>
+
+#include <network/characterlistcache.h>
 
 #include <script/lua.h>
 
@@ -50,8 +54,14 @@ bool Redis::connect()
 		return false;
 
 
+	g_redisRequests.setTimeout(g_config->get<int>("redisRequestTimeout", 30) * 1000);
+
+	if (g_characterListCache.isEnabled() && !g_redisSubscriber->subscribe(g_characterListCache.getChannel()))
+		return false;
+
 	g_redisSubscriber->start();
 	g_dispatcher.start();
+	g_scheduler.start();
 
 	return true;
 }
@@ -75,12 +85,12 @@ int Redis::Select(int fd, int timeout_sec)
 
 #ifdef _WIN32
 	if (result == SOCKET_ERROR) {
-		g_logger.error(fmt::format("select() failed: {:s}", WSAGetLastError()));
+		g_logger.error("select() failed: {:d}", WSAGetLastError());
 		return -1;
 	}
 #else
 	if (result == -1) {
-        g_logger.error(fmt::format("select() failed: {:s}", strerror(errno)));
+        g_logger.error("select() failed: {:s}", strerror(errno));
 		return -1;
 	}
 #endif
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <redis/requests.h>
+#include <redis/pub.h>
+
+#include <core/logger.h>
+#include <core/scheduler.h>
+#include <core/tracer.h>
+
+RedisRequests g_redisRequests;
+
+bool RedisRequests::request(const std::string& channel, const std::vector<std::pair<std::string, std::string>>& fields, Callback callback, uint32_t timeout)
+{
+    const uint64_t answerId = nextId();
+
+    std::string payload = "{";
+    for (const auto& [key, value] : fields) {
+        payload += escapeJsonString(key) + ":" + escapeJsonString(value) + ",";
+    }
+    payload += fmt::format("\"__answer\":true,\"__answerId\":{:d}}}", answerId);
+
+    return send(answerId, channel, payload, std::move(callback), timeout);
+}
+
+bool RedisRequests::send(uint64_t answerId, const std::string& channel, const std::string& payload, Callback callback, uint32_t timeout)
+{
+    // the answer arrives on the subscriber thread, record the round trip from the callback
+    if (const uint64_t trace = Tracer::getCurrentTrace()) {
+        callback = [trace, start = Tracer::now(), callback = std::move(callback)](const Answer& answer) {
+            g_tracer.recordAsync(trace, "redis.request", start, Tracer::now());
+            TraceContext traceContext(trace);
+            callback(answer);
+        };
+    }
+
+    uint32_t timeoutEvent = g_scheduler.addEvent(createSchedulerTask(timeout != 0 ? timeout : m_timeout, [this, answerId]() {
+        expire(answerId);
+    }));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[answerId] = {std::move(callback), timeoutEvent};
+    }
+
+    if (!g_redisPublisher->publish(channel, payload)) {
+        g_scheduler.stopEvent(timeoutEvent);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.erase(answerId);
+        return false;
+    }
+
+    return true;
+}
+
+bool RedisRequests::dispatchAnswer(const std::string& message)
+{
+    if (message.find("\"__answerId\"") == std::string::npos) {
+        return false;
+    }
+
+    Answer answer;
+    if (!parseJsonObject(message, answer.fields)) {
+        return false;
+    }
+
+    auto idIt = answer.fields.find("__answerId");
+    if (idIt == answer.fields.end()) {
+        return false;
+    }
+
+    const uint64_t answerId = std::strtoull(idIt->second.c_str(), nullptr, 10);
+
+    PendingRequest request;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(answerId);
+        if (it == m_pending.end()) {
+            return false;
+        }
+
+        request = std::move(it->second);
+        m_pending.erase(it);
+    }
+
+    g_scheduler.stopEvent(request.timeoutEvent);
+
+    answer.fields.erase("__answer");
+    answer.fields.erase("__answerId");
+    answer.message = message;
+
+    g_dispatcher.addTask(createTask([callback = std::move(request.callback), answer = std::move(answer)]() {
+        callback(answer);
+    }));
+    return true;
+}
+
+void RedisRequests::expire(uint64_t answerId)
+{
+    Callback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(answerId);
+        if (it == m_pending.end()) {
+            return;
+        }
+
+        callback = std::move(it->second.callback);
+        m_pending.erase(it);
+    }
+
+    g_logger.warning("[RedisRequests] Request {:d} timed out", answerId);
+
+    Answer answer;
+    answer.timedOut = true;
+    callback(answer);
+}
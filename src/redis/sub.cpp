@@ -9,10 +9,14 @@
 
 #include <redis/redis.h>
 #include <redis/sub.h>
+#include <redis/requests.h>
 
 #include <core/modulemanager.h>
 #include <core/logger.h>
 #include <core/tasks.h>
+#include <core/faultinjector.h>
+
+#include <network/characterlistcache.h>
 
 RedisSubscriberPtr g_redisSubscriber = std::make_shared<RedisSubscriber>();
 
@@ -26,7 +30,7 @@ bool RedisSubscriber::connect(const std::string& host, int port)
 {
     m_context = redisConnect(host.c_str(), port);
     if (!m_context || m_context->err) {
-        g_logger.error(fmt::format("[RedisSubscriber] Failed to estabilish connection. address: {:s}:{:d}", host, port));
+        g_logger.error("[RedisSubscriber] Failed to estabilish connection. address: {:s}:{:d}", host, port);
         return false;
     }
 
@@ -40,7 +44,7 @@ bool RedisSubscriber::subscribe(const std::string& channel)
         freeReplyObject(reply);
         return true;
     } else {
-        g_logger.error(fmt::format("[RedisSubscriber] Failed to subscribe to channel: {:s}", channel));
+        g_logger.error("[RedisSubscriber] Failed to subscribe to channel: {:s}", channel);
     }
 
     return false;
@@ -59,7 +63,7 @@ void RedisSubscriber::threadMain()
 		}
 
 		if (redisBufferRead(m_context) != REDIS_OK) {
-			g_logger.error(fmt::format("[RedisSubscriber] redisBufferRead() failed: {:s}", m_context->errstr));
+			g_logger.error("[RedisSubscriber] redisBufferRead() failed: {:s}", m_context->errstr);
 			break;
 		}
 
@@ -73,7 +77,7 @@ void RedisSubscriber::threadMain()
 						channel = reply->element[1]->str;
 
 				if (channel.empty()) {
-					g_logger.error(fmt::format("[RedisSubscriber] Not found channel. type: {:s}",type));
+					g_logger.error("[RedisSubscriber] Not found channel. type: {:s}",type);
 					continue;
 				}
 
@@ -84,14 +88,22 @@ void RedisSubscriber::threadMain()
 						message = reply->element[2]->str;
 
 					if (message.empty()) {
-						g_logger.error(fmt::format("[RedisSubscriber] Not found message. channel: {:s}", channel));
+						g_logger.error("[RedisSubscriber] Not found message. channel: {:s}", channel);
 						continue;
 					}
 
-					g_dispatcher.addTask(createTask([this, channel, message]() {
-						std::lock_guard<std::mutex> lock(m_mutex);
-						g_modules->emitNoRet("onRedisMessage", channel.c_str(), std::tuple{ "message", message.c_str() });
-					}));
+					// an injected error loses the message, its latency holds up the ones behind it
+					if (!g_faultInjector.inject(FaultTarget::RedisDelivery)) {
+						g_logger.error("[RedisSubscriber] Injected failure, message on channel {:s} dropped", channel);
+					} else if (g_characterListCache.isEnabled() && channel == g_characterListCache.getChannel()) {
+						g_characterListCache.handleMessage(message);
+					} else if (!g_redisRequests.dispatchAnswer(message)) {
+						// answers to native requests skip the Lua modules
+						g_dispatcher.addTask(createTask([this, channel, message]() {
+							std::lock_guard<std::mutex> lock(m_mutex);
+							g_modules->emitNoRet("onRedisMessage", channel.c_str(), std::tuple{ "message", message.c_str() });
+						}));
+					}
 				}
 			}
 			freeReplyObject(reply);
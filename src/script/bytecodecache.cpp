@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fstream>
+#include <iterator>
+#include <fmt/format.h>
+
+#include <script/bytecodecache.h>
+#include <script/lua.h>
+#include <core/logger.h>
+
+namespace
+{
+    constexpr char CACHE_MAGIC[8] = "PWOLBC1";
+
+    // FNV-1a
+    uint64_t hashSource(const std::string& source)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : source) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool readFile(const std::filesystem::path& path, std::string& content)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+
+    int writeChunk(lua_State*, const void* data, size_t size, void* ud)
+    {
+        static_cast<std::string*>(ud)->append(static_cast<const char*>(data), size);
+        return 0;
+    }
+}
+
+bool BytecodeCache::setDirectory(const std::string& directory)
+{
+    m_directory.clear();
+    if (directory.empty()) {
+        return true;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        g_logger.warning("[BytecodeCache] Can not create {:s}: {:s}, the cache is disabled", directory, ec.message());
+        return false;
+    }
+
+    m_directory = directory;
+    return true;
+}
+
+int BytecodeCache::load(lua_State* L, const std::string& file)
+{
+    std::string source;
+    // luaL_loadfile reports unreadable files and skips a leading #! line
+    if (!readFile(file, source) || (!source.empty() && source[0] == '#')) {
+        return luaL_loadfile(L, file.c_str());
+    }
+
+    const std::string chunkName = "@" + file;
+    if (!isEnabled()) {
+        return luaL_loadbuffer(L, source.data(), source.size(), chunkName.c_str());
+    }
+
+    std::error_code ec;
+    Header header{};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.mtime = static_cast<int64_t>(std::filesystem::last_write_time(file, ec).time_since_epoch().count());
+    header.size = source.size();
+    header.hash = hashSource(source);
+    strncpy(header.version, LUAJIT_VERSION, sizeof(header.version) - 1);
+
+    const std::filesystem::path cachePath = getCachePath(file);
+
+    std::string cached;
+    if (readFile(cachePath, cached) && cached.size() > sizeof(Header) && memcmp(cached.data(), &header, sizeof(Header)) == 0) {
+        if (luaL_loadbuffer(L, cached.data() + sizeof(Header), cached.size() - sizeof(Header), chunkName.c_str()) == 0) {
+            ++m_hits;
+            return 0;
+        }
+
+        // bytecode of another LuaJIT build, compile it again
+        lua_pop(L, 1);
+    }
+
+    ++m_misses;
+    int ret = luaL_loadbuffer(L, source.data(), source.size(), chunkName.c_str());
+    if (ret == 0) {
+        store(L, cachePath, header);
+    }
+    return ret;
+}
+
+std::filesystem::path BytecodeCache::getCachePath(const std::string& file) const
+{
+    // one flat directory, modules/login/login.lua -> modules%login%login.lua.bc
+    std::string name = std::filesystem::path(file).lexically_normal().generic_string();
+    for (char& c : name) {
+        if (c == '/' || c == ':') {
+            c = '%';
+        }
+    }
+    return m_directory / (name + ".bc");
+}
+
+void BytecodeCache::store(lua_State* L, const std::filesystem::path& cachePath, const Header& header)
+{
+    std::string content(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if (lua_dump(L, writeChunk, &content) != 0) {
+        return;
+    }
+
+    // written aside and renamed, a crash never leaves a truncated cache file
+    std::filesystem::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.write(content.data(), content.size())) {
+            g_logger.warning("[BytecodeCache] Can not write {:s}", tempPath.string());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        g_logger.warning("[BytecodeCache] Can not write {:s}: {:s}", cachePath.string(), ec.message());
+        std::filesystem::remove(tempPath, ec);
+    }
+}
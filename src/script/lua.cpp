@@ -6,22 +6,36 @@
  */
 
 #include <script/lua.h>
+#include <script/luapacket.h>
 
 #include <core/module.h>
 #include <core/modulemanager.h>
 #include <core/logger.h>
+#include <core/tasks.h>
+#include <core/metrics.h>
 
 #include <redis/pub.h>
 #include <redis/sub.h>
+#include <redis/requests.h>
+
+#include <database/database.h>
+#include <database/databasetasks.h>
 
 #include <network/connectionmanager.h>
+#include <network/packetformat.h>
+#include <network/packets.h>
 
 LuaScriptPtr g_lua = std::make_shared<LuaScript>();
 LuaTablePtr g_config = nullptr;
 
 LuaScript::LuaScript()
 {
-    m_luaState = luaL_newstate();
+    m_luaState = lua_newstate(LuaAllocator::alloc, &m_allocator);
+    m_allocatorAccounting = m_luaState != nullptr;
+    if (!m_luaState) {
+        // LuaJIT on x64 without GC64 only runs on its own allocator
+        m_luaState = luaL_newstate();
+    }
     luaL_openlibs(m_luaState);
 }
 
@@ -48,6 +62,27 @@ bool LuaScript::init()
 		pop(m_luaState);
 	}
 
+	if (m_allocatorAccounting) {
+		m_allocator.setLimits(g_config->get<uint32_t>("luaModuleMemorySoftLimit", 0) * 1024, g_config->get<uint32_t>("luaModuleMemoryHardLimit", 0) * 1024);
+	} else {
+		g_logger.warning("Lua state runs on the LuaJIT allocator, no per module memory accounting");
+	}
+
+	// config.lua itself is always compiled from source
+	m_bytecodeCache.setDirectory(g_config->get<std::string>("luaBytecodeCache", ""));
+
+	// the automatic collector stays as a backstop when the dispatcher is never idle
+	lua_gc(m_luaState, LUA_GCSETPAUSE, g_config->get<int32_t>("luaGcPause", 200));
+	lua_gc(m_luaState, LUA_GCSETSTEPMUL, g_config->get<int32_t>("luaGcStepMul", 200));
+	m_gcStepSize = g_config->get<int32_t>("luaGcIdleStepSize", 16);
+	m_gcIdleThreshold = g_config->get<int32_t>("luaGcIdleThreshold", 50);
+	if (m_gcStepSize > 0) {
+		g_dispatcher.setIdleHandler([this]() { return stepGarbageCollector(); });
+	}
+
+	// lib/lib.lua loads the other libraries through dofile
+	registerGlobalFunction("dofile", LuaScript::luaDofile);
+
 	if (loadFile("lib/lib.lua") == -1) {
 		g_logger.fatal("Failed to load lib/lib.lua");
 		return false;
@@ -55,6 +90,9 @@ bool LuaScript::init()
 
 	// Global Functions
 	registerGlobalFunction("emit", LuaScript::luaEmit);
+	registerGlobalFunction("spawn", LuaScript::luaSpawn);
+	registerGlobalFunction("memoryStats", LuaScript::luaMemoryStats);
+	registerGlobalFunction("gcStats", LuaScript::luaGcStats);
 
 	// g_login
 	registerTable("g_login");
@@ -64,6 +102,25 @@ bool LuaScript::init()
 	registerTable("g_redis");
 	registerTableFunction("g_redis", "publish", LuaScript::luaRedisPublish);
 	registerTableFunction("g_redis", "subscribe", LuaScript::luaRedisSubscribe);
+	registerTableFunction("g_redis", "nextRequestId", LuaScript::luaRedisNextRequestId);
+	registerTableFunction("g_redis", "awaitAnswer", LuaScript::luaRedisAwaitAnswer);
+
+	// g_logger
+	registerTable("g_logger");
+	registerTableFunction("g_logger", "info", LuaScript::luaLoggerInfo);
+	registerTableFunction("g_logger", "warning", LuaScript::luaLoggerWarning);
+	registerTableFunction("g_logger", "error", LuaScript::luaLoggerError);
+
+	// g_profiler
+	registerTable("g_profiler");
+	registerTableFunction("g_profiler", "start", LuaScript::luaProfilerStart);
+	registerTableFunction("g_profiler", "stop", LuaScript::luaProfilerStop);
+	registerTableFunction("g_profiler", "dump", LuaScript::luaProfilerDump);
+
+	// db
+	registerTable("db");
+	registerTableFunction("db", "query", LuaScript::luaDatabaseQuery);
+	registerTableFunction("db", "escapeString", LuaScript::luaDatabaseEscapeString);
 
 	// Module
 	registerClass("Module");
@@ -90,18 +147,58 @@ bool LuaScript::init()
 	registerStaticMethod("NetworkMessage", "addU64", LuaScript::luaNetworkMessageAddU64);
 	registerStaticMethod("NetworkMessage", "addString", LuaScript::luaNetworkMessageAddString);
 
+	registerStaticMethod("NetworkMessage", "read", LuaScript::luaNetworkMessageRead);
+	registerStaticMethod("NetworkMessage", "write", LuaScript::luaNetworkMessageWrite);
+
 	// OutputMessage
 	registerClass("OutputMessage", "NetworkMessage", LuaScript::luaOutputMessageCreate);
 	registerStaticMetaMethod("OutputMessage", "__gc", LuaScript::luaOutputMessageDelete);
 	registerStaticMethod("OutputMessage", "delete", LuaScript::luaOutputMessageDelete);
 
+	// Packet, codecs generated from the schemas in network/packets.h
+	registerTable("Packet");
+	LuaPacket::registerPacket<Packets::Error>(m_luaState, "Error");
+	LuaPacket::registerPacket<Packets::Motd>(m_luaState, "Motd");
+	LuaPacket::registerPacket<Packets::SessionKey>(m_luaState, "SessionKey");
+	LuaPacket::registerPacket<Packets::LoadingMessage>(m_luaState, "LoadingMessage");
+	LuaPacket::registerPacket<Packets::CharacterList>(m_luaState, "CharacterList");
+	LuaPacket::registerPacket<Packets::GameServerHostRequest>(m_luaState, "GameServerHostRequest");
+	LuaPacket::registerPacket<Packets::GameServerHost>(m_luaState, "GameServerHost");
+
+	// NetworkMessage.layout, read by the FFI binding
+	const NetworkMessage::Layout layout = NetworkMessage::getLayout();
+	putGlobalOnStack(m_luaState, "NetworkMessage");
+	lua_createtable(m_luaState, 0, 7);
+	pushTuple(m_luaState, std::tuple{"length", static_cast<uint32_t>(layout.length)});
+	pushTuple(m_luaState, std::tuple{"position", static_cast<uint32_t>(layout.position)});
+	pushTuple(m_luaState, std::tuple{"overrun", static_cast<uint32_t>(layout.overrun)});
+	pushTuple(m_luaState, std::tuple{"buffer", static_cast<uint32_t>(layout.buffer)});
+	pushTuple(m_luaState, std::tuple{"maxSize", static_cast<int>(NETWORKMESSAGE_MAXSIZE)});
+	pushTuple(m_luaState, std::tuple{"maxBodyLength", static_cast<int>(NetworkMessage::MAX_BODY_LENGTH)});
+	pushTuple(m_luaState, std::tuple{"initialPosition", static_cast<int>(NetworkMessage::INITIAL_BUFFER_POSITION)});
+	lua_setfield(m_luaState, -2, "layout");
+	pop(m_luaState);
+
+	// LuaJIT FFI fast path for NetworkMessage, the C API above stays as fallback
+	if (g_config->get<bool>("luaFFI", true) && loadFile("lib/networkmessage.lua") == -1) {
+		g_logger.warning("Failed to load lib/networkmessage.lua, NetworkMessage will use the C API");
+		g_logger.trace(getLastLuaError());
+	}
+
+	m_watchdog.setBudget(g_config->get<uint32_t>("luaCallbackInstructionBudget", 0), g_config->get<uint32_t>("luaCallbackTimeBudget", 0),
+		g_config->get<uint32_t>("luaCallbackHookInterval", 1000), g_config->get<uint32_t>("luaCallbackMaxViolations", 0));
+
+	if (g_config->get<bool>("luaProfiler", false)) {
+		m_profiler.start(m_luaState, g_config->get<uint32_t>("luaProfilerInterval", 1));
+	}
+
 	return true;
 }
 
 int32_t LuaScript::loadFile(const std::string& file)
 {
 	//loads file as a chunk at stack top
-	int ret = luaL_loadfile(m_luaState, file.c_str());
+	int ret = m_bytecodeCache.load(m_luaState, file);
 	if (ret != 0) {
 		m_lastLuaError = popString(m_luaState);
 		return -1;
@@ -179,6 +276,74 @@ std::string LuaScript::getStackTrace(lua_State* L, const std::string& error_desc
 	return popString(L);
 }
 
+void LuaScript::resumeCoroutine(lua_State* co, int nargs)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	auto it = m_coroutines.find(co);
+	if (it == m_coroutines.end()) {
+		return;
+	}
+
+	static const std::string RESUME_EVENT = "resume";
+
+	int ret;
+	{
+		MetricTimer resumeTimer(g_metrics.luaCallbackTime);
+		LuaAllocator::OwnerScope scope(m_allocator, it->second.owner);
+		LuaWatchdog::Scope budget(m_watchdog, m_luaState, nullptr, it->second.owner, RESUME_EVENT, 0, RESUME_EVENT);
+		ret = lua_resume(co, nargs);
+	}
+
+	if (ret == LUA_YIELD) {
+		// waiting for the next answer
+		return;
+	}
+
+	if (ret != 0) {
+		luaL_traceback(m_luaState, co, popString(co).c_str(), 0);
+		reportError(nullptr, popString(m_luaState));
+	}
+
+	int32_t coroutineRef = it->second.ref;
+	m_coroutines.erase(it);
+	luaL_unref(m_luaState, LUA_REGISTRYINDEX, coroutineRef);
+}
+
+bool LuaScript::stepGarbageCollector()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	if (!m_gcCycleRunning) {
+		// only start a cycle once enough garbage may have piled up
+		if (lua_gc(m_luaState, LUA_GCCOUNT, 0) * 100 < m_gcStats.liveSize * (100 + m_gcIdleThreshold)) {
+			return false;
+		}
+
+		m_gcCycleRunning = true;
+		m_gcCycleSteps = 0;
+		m_gcCycleTime = 0;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	bool finished = lua_gc(m_luaState, LUA_GCSTEP, m_gcStepSize) == 1;
+	m_gcCycleTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	++m_gcCycleSteps;
+
+	if (!finished) {
+		return true;
+	}
+
+	m_gcCycleRunning = false;
+	++m_gcStats.cycles;
+	m_gcStats.lastCycleSteps = m_gcCycleSteps;
+	m_gcStats.lastCycleTime = m_gcCycleTime;
+	m_gcStats.totalTime += m_gcCycleTime;
+	m_gcStats.liveSize = lua_gc(m_luaState, LUA_GCCOUNT, 0);
+	g_metrics.luaMemory.set(static_cast<int64_t>(m_gcStats.liveSize) * 1024);
+	g_metrics.luaGcCycleTime.observe(static_cast<uint64_t>(m_gcCycleTime * 1000));
+	g_logger.debug("[LuaGC] Cycle finished in {:.2f} ms over {:d} steps, {:d} KB in use", m_gcCycleTime, m_gcCycleSteps, m_gcStats.liveSize);
+	return false;
+}
+
 int LuaScript::ref(lua_State* L)
 {
     int ref = luaL_ref(L, LUA_REGISTRYINDEX);
@@ -232,7 +397,7 @@ void LuaScript::registerTable(const std::string& tableName)
 
 void LuaScript::registerTableFunction(const std::string& tableName, const std::string& functionName, lua_CFunction function)
 {
-	int luaTop = lua_gettop(m_luaState);
+	[[maybe_unused]] int luaTop = lua_gettop(m_luaState);
 
 	putGlobalOnStack(m_luaState, tableName);
 	assert(LuaScript::isTable(m_luaState, -1));
@@ -318,6 +483,115 @@ int32_t LuaScript::luaEmit(lua_State* L)
     return getTop(L);
 }
 
+int32_t LuaScript::luaSpawn(lua_State* L)
+{
+	// spawn(function, ...)
+	if (!isFunction(L, 1)) {
+		reportErrorFunc(L, "spawn expects a function");
+		clearStack(L);
+		LuaStack::Push<bool>::Value(L, false);
+		return getTop(L);
+	}
+
+	const int nargs = getTop(L) - 1;
+
+	lua_State* co = lua_newthread(L);
+	g_lua->m_coroutines[co] = {ref(L), g_lua->m_allocator.getCurrentOwner()};
+
+	// function and arguments
+	lua_xmove(L, co, nargs + 1);
+	g_lua->resumeCoroutine(co, nargs);
+
+	LuaStack::Push<bool>::Value(L, true);
+	return getTop(L);
+}
+
+int32_t LuaScript::luaMemoryStats(lua_State* L)
+{
+	// memoryStats()
+	const auto& owners = g_lua->m_allocator.getStats();
+	lua_createtable(L, 0, owners.size());
+	for (const auto& owner : owners) {
+		lua_createtable(L, 0, 4);
+		pushTuple(L, std::tuple{"bytes", static_cast<double>(owner.bytes)});
+		pushTuple(L, std::tuple{"peak", static_cast<double>(owner.peak)});
+		pushTuple(L, std::tuple{"allocations", static_cast<double>(owner.allocations)});
+		pushTuple(L, std::tuple{"failures", static_cast<double>(owner.failures)});
+		lua_setfield(L, -2, owner.name.c_str());
+	}
+	return getTop(L);
+}
+
+int32_t LuaScript::luaGcStats(lua_State* L)
+{
+	// gcStats()
+	const GcStats& stats = g_lua->m_gcStats;
+	lua_createtable(L, 0, 6);
+	pushTuple(L, std::tuple{"cycles", static_cast<double>(stats.cycles)});
+	pushTuple(L, std::tuple{"lastCycleSteps", static_cast<double>(stats.lastCycleSteps)});
+	pushTuple(L, std::tuple{"lastCycleTime", stats.lastCycleTime});
+	pushTuple(L, std::tuple{"totalTime", stats.totalTime});
+	pushTuple(L, std::tuple{"liveSize", static_cast<double>(stats.liveSize)});
+	pushTuple(L, std::tuple{"size", static_cast<double>(lua_gc(L, LUA_GCCOUNT, 0))});
+	return getTop(L);
+}
+
+int32_t LuaScript::luaDofile(lua_State* L)
+{
+	// dofile(file), the base library one without the bytecode cache
+	std::string file = luaL_checkstring(L, 1);
+	lua_settop(L, 0);
+	if (g_lua->m_bytecodeCache.load(L, file) != 0) {
+		return lua_error(L);
+	}
+
+	lua_call(L, 0, LUA_MULTRET);
+	return getTop(L);
+}
+
+int32_t LuaScript::luaLoggerInfo(lua_State* L)
+{
+	// g_logger.info(message)
+	g_logger.info(getString(L, 1));
+	return 0;
+}
+
+int32_t LuaScript::luaLoggerWarning(lua_State* L)
+{
+	// g_logger.warning(message)
+	g_logger.warning(getString(L, 1));
+	return 0;
+}
+
+int32_t LuaScript::luaLoggerError(lua_State* L)
+{
+	// g_logger.error(message)
+	g_logger.error(getString(L, 1));
+	return 0;
+}
+
+int32_t LuaScript::luaProfilerStart(lua_State* L)
+{
+	// g_profiler.start([interval])
+	uint32_t interval = getNumber<uint32_t>(L, 1, g_config->get<uint32_t>("luaProfilerInterval", 1));
+	g_lua->m_profiler.start(g_lua->m_luaState, interval);
+	return 0;
+}
+
+int32_t LuaScript::luaProfilerStop(lua_State*)
+{
+	// g_profiler.stop()
+	g_lua->m_profiler.stop(g_lua->m_luaState);
+	return 0;
+}
+
+int32_t LuaScript::luaProfilerDump(lua_State* L)
+{
+	// g_profiler.dump()
+	LuaStack::Push<bool>::Value(L, g_lua->m_profiler.dump(g_config->get<std::string>("luaProfilerDirectory", "profile")));
+	return 1;
+}
+
 int32_t LuaScript::luaLoginGetClient(lua_State* L)
 {
 	// g_login.getClient(id)
@@ -347,6 +621,95 @@ int32_t LuaScript::luaRedisSubscribe(lua_State* L)
 	return getTop(L);
 }
 
+int32_t LuaScript::luaRedisNextRequestId(lua_State* L)
+{
+	// g_redis.nextRequestId()
+	LuaStack::Push<uint64_t>::Value(L, g_redisRequests.nextId());
+	return getTop(L);
+}
+
+int32_t LuaScript::luaRedisAwaitAnswer(lua_State* L)
+{
+	// g_redis.awaitAnswer(channel, payload, answerId[, timeout])
+	if (!g_lua->isCoroutine(L)) {
+		return luaL_error(L, "g_redis.request has to run in a coroutine (spawn/async)");
+	}
+
+	uint32_t timeout = getNumber<uint32_t>(L, 4, 0);
+	uint64_t answerId = getNumber<uint64_t>(L, 3);
+	std::string payload = getString(L, 2);
+	std::string channel = getString(L, 1);
+	clearStack(L);
+
+	bool sent = g_redisRequests.send(answerId, channel, payload, [L](const RedisRequests::Answer& answer) {
+		std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
+		if (answer.timedOut) {
+			lua_pushnil(L);
+			pushString(L, "timeout");
+			g_lua->resumeCoroutine(L, 2);
+			return;
+		}
+
+		pushString(L, answer.message);
+		g_lua->resumeCoroutine(L, 1);
+	}, timeout);
+
+	if (!sent) {
+		lua_pushnil(L);
+		pushString(L, "publish failed");
+		return getTop(L);
+	}
+
+	return lua_yield(L, 0);
+}
+
+int32_t LuaScript::luaDatabaseQuery(lua_State* L)
+{
+	// db.query(query)
+	if (!g_lua->isCoroutine(L)) {
+		return luaL_error(L, "db.query has to run in a coroutine (spawn/async)");
+	}
+
+	std::string query = LuaStack::Pop<std::string>::Value(L);
+	clearStack(L);
+
+	bool queued = g_databaseTasks.addTask(std::move(query), [L](DBResultSharedPtr result) {
+		std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
+		// rows as arrays of {column = value}, NULL columns are nil, binary values keep their '\0'
+		lua_newtable(L);
+		if (result) {
+			const auto& columns = result->getColumns();
+			for (int index = 1; result->hasNext(); result->next(), ++index) {
+				lua_createtable(L, 0, columns.size());
+				for (size_t column = 0; column < columns.size(); ++column) {
+					if (const char* value = result->getValue(column)) {
+						lua_pushlstring(L, value, result->getLength(column));
+						lua_setfield(L, -2, columns[column].c_str());
+					}
+				}
+				lua_rawseti(L, -2, index);
+			}
+		}
+		g_lua->resumeCoroutine(L, 1);
+	});
+
+	if (!queued) {
+		lua_pushnil(L);
+		pushString(L, "database unavailable");
+		return getTop(L);
+	}
+
+	return lua_yield(L, 0);
+}
+
+int32_t LuaScript::luaDatabaseEscapeString(lua_State* L)
+{
+	// db.escapeString(value)
+	std::string value = LuaStack::Pop<std::string>::Value(L);
+	pushString(L, g_database.escapeString(value));
+	return getTop(L);
+}
+
 int32_t LuaScript::luaModuleConnect(lua_State* L)
 {
 	// Module:connect(event, callback, [identifier])
@@ -362,19 +725,28 @@ int32_t LuaScript::luaModuleConnect(lua_State* L)
 	int32_t callback = ref(L);
 	std::string event = LuaStack::Pop<std::string>::Value(L);
 
-	Module* module = LuaStack::Pop<Module>::Value(L);
+	// the userdata stays on the stack for the disconnect closure
+	Module* module = getUserdata<Module>(L, 1);
 	if (!module) {
+		clearStack(L);
 		LuaStack::Push<bool>::Value(L, false);
 		return getTop(L);
 	}
 
 	if (!module->connect(event, callback, identifier)) {
+		clearStack(L);
 		LuaStack::Push<bool>::Value(L, false);
 		return getTop(L);
 	}
 
 	auto disconnect = [](lua_State* L) -> int {
-		Module* _module = static_cast<Module*>(lua_touserdata(L, lua_upvalueindex(1)));
+		// nullptr once a reload released the module version
+		Module* _module = getUserdata<Module>(L, lua_upvalueindex(1));
+		if (!_module) {
+			LuaStack::Push<bool>::Value(L, false);
+			return 1;
+		}
+
 		std::shared_ptr<std::string>* _event = static_cast<std::shared_ptr<std::string>*>(lua_touserdata(L, lua_upvalueindex(2)));
 		std::shared_ptr<std::string>* _identifier = static_cast<std::shared_ptr<std::string>*>(lua_touserdata(L, lua_upvalueindex(3)));
 
@@ -391,11 +763,12 @@ int32_t LuaScript::luaModuleConnect(lua_State* L)
 	std::shared_ptr<std::string>* identifierUserdata = static_cast<std::shared_ptr<std::string>*>(lua_newuserdata(L, sizeof(std::shared_ptr<std::string>)));
 	new (identifierUserdata) std::shared_ptr<std::string>(identifierPtr);
 
-	lua_pushlightuserdata(L, module);
+	lua_pushvalue(L, 1);
 	lua_pushlightuserdata(L, eventUserdata);
 	lua_pushlightuserdata(L, identifierUserdata);
 
 	lua_pushcclosure(L, disconnect, 3);
+	lua_remove(L, 1);
 	return getTop(L);
 }
 
@@ -417,7 +790,7 @@ int32_t LuaScript::luaProtocolSend(lua_State* L)
 	// Protocol:send(msg)
 	OutputMessage* msg = LuaStack::Pop<OutputMessage>::Value(L);
 	Protocol* protocol = LuaStack::Pop<Protocol>::Value(L);
-	if (!protocol) {
+	if (!protocol || !msg) {
 		LuaStack::Push<bool>::Value(L, false);
 		return LuaScript::getTop(L);
 	}
@@ -518,7 +891,7 @@ int32_t LuaScript::luaNetworkMessageGetString(lua_State* L)
 		return LuaScript::getTop(L);
 	}
 
-	LuaStack::Push<std::string>::Value(L, msg->getString());
+	pushString(L, msg->getStringView());
 	return LuaScript::getTop(L);
 }
 
@@ -585,14 +958,103 @@ int32_t LuaScript::luaNetworkMessageAddU64(lua_State* L)
 int32_t LuaScript::luaNetworkMessageAddString(lua_State* L)
 {
 	// NetworkMessage:addString(value)
-	std::string value = LuaStack::Pop<std::string>::Value(L);
+	// the value is read in place, the stack is cleared after the copy into the message
+	NetworkMessage* msg = getNetworkMessage(L, 1);
+	if (!msg) {
+		clearStack(L);
+		LuaStack::Push<bool>::Value(L, false);
+		return LuaScript::getTop(L);
+	}
+
+	msg->addString(getStringView(L, 2));
+	clearStack(L);
+	LuaStack::Push<bool>::Value(L, true);
+	return LuaScript::getTop(L);
+}
+
+int32_t LuaScript::luaNetworkMessageRead(lua_State* L)
+{
+	// NetworkMessage:read(format)
+	std::string pattern = LuaStack::Pop<std::string>::Value(L);
 	NetworkMessage* msg = LuaStack::Pop<NetworkMessage>::Value(L);
 	if (!msg) {
+		lua_pushnil(L);
+		return LuaScript::getTop(L);
+	}
+
+	const PacketFormat* format = PacketFormat::get(pattern);
+	if (!format) {
+		reportErrorFunc(L, fmt::format("Invalid packet format '{:s}'", pattern));
+		lua_pushnil(L);
+		return LuaScript::getTop(L);
+	}
+
+	lua_checkstack(L, static_cast<int>(format->size()));
+	for (PacketFormat::FieldType field : format->getFields()) {
+		switch (field) {
+			case PacketFormat::FieldType::U8:
+				LuaStack::Push<uint8_t>::Value(L, msg->getByte());
+				break;
+			case PacketFormat::FieldType::U16:
+				LuaStack::Push<uint16_t>::Value(L, msg->get<uint16_t>());
+				break;
+			case PacketFormat::FieldType::U32:
+				LuaStack::Push<uint32_t>::Value(L, msg->get<uint32_t>());
+				break;
+			case PacketFormat::FieldType::U64:
+				LuaStack::Push<uint64_t>::Value(L, msg->get<uint64_t>());
+				break;
+			case PacketFormat::FieldType::String:
+				pushString(L, msg->getStringView());
+				break;
+		}
+	}
+
+	return LuaScript::getTop(L);
+}
+
+int32_t LuaScript::luaNetworkMessageWrite(lua_State* L)
+{
+	// NetworkMessage:write(format, ...)
+	NetworkMessage* msg = getNetworkMessage(L, 1);
+	std::string pattern = getString(L, 2);
+	if (!msg) {
+		clearStack(L);
+		LuaStack::Push<bool>::Value(L, false);
+		return LuaScript::getTop(L);
+	}
+
+	const PacketFormat* format = PacketFormat::get(pattern);
+	if (!format) {
+		reportErrorFunc(L, fmt::format("Invalid packet format '{:s}'", pattern));
+		clearStack(L);
 		LuaStack::Push<bool>::Value(L, false);
 		return LuaScript::getTop(L);
 	}
 
-	msg->addString(value);
+	int index = 3;
+	for (PacketFormat::FieldType field : format->getFields()) {
+		switch (field) {
+			case PacketFormat::FieldType::U8:
+				msg->addByte(static_cast<uint8_t>(lua_tonumber(L, index)));
+				break;
+			case PacketFormat::FieldType::U16:
+				msg->add<uint16_t>(static_cast<uint16_t>(lua_tonumber(L, index)));
+				break;
+			case PacketFormat::FieldType::U32:
+				msg->add<uint32_t>(static_cast<uint32_t>(lua_tonumber(L, index)));
+				break;
+			case PacketFormat::FieldType::U64:
+				msg->add<uint64_t>(static_cast<uint64_t>(lua_tonumber(L, index)));
+				break;
+			case PacketFormat::FieldType::String:
+				msg->addString(getStringView(L, index));
+				break;
+		}
+		++index;
+	}
+
+	clearStack(L);
 	LuaStack::Push<bool>::Value(L, true);
 	return LuaScript::getTop(L);
 }
@@ -606,7 +1068,7 @@ int32_t LuaScript::luaOutputMessageCreate(lua_State* L)
 
 int32_t LuaScript::luaOutputMessageDelete(lua_State* L)
 {
-	OutputMessage** outputPtr = getRawUserdata<OutputMessage>(L, 1);
+	OutputMessage** outputPtr = isUserdataOf(L, 1, "OutputMessage") ? getRawUserdata<OutputMessage>(L, 1) : nullptr;
 	if (outputPtr && *outputPtr) {
 		delete *outputPtr;
 		*outputPtr = nullptr;
@@ -677,6 +1139,27 @@ void LuaScript::setMetatable(int index)
     lua_setmetatable(m_luaState, index);
 }
 
+bool LuaScript::isUserdataOf(lua_State* L, int32_t arg, const char* className)
+{
+	if (!lua_isuserdata(L, arg) || !lua_getmetatable(L, arg)) {
+		return false;
+	}
+
+	luaL_getmetatable(L, className);
+	bool equal = lua_rawequal(L, -1, -2) != 0;
+	lua_pop(L, 2);
+	return equal;
+}
+
+NetworkMessage* LuaScript::getNetworkMessage(lua_State* L, int32_t arg)
+{
+	// OutputMessage inherits the NetworkMessage methods, both hold a NetworkMessage*
+	if (!isUserdataOf(L, arg, "NetworkMessage") && !isUserdataOf(L, arg, "OutputMessage")) {
+		return nullptr;
+	}
+	return getUserdata<NetworkMessage>(L, arg);
+}
+
 void LuaScript::setMetatable(lua_State* L, int32_t index, const std::string& name)
 {
 	luaL_getmetatable(L, name.c_str());
@@ -713,7 +1196,7 @@ void LuaScript::startTrackStack(lua_State* L)
 
 void LuaScript::endTrackStack(lua_State* L)
 {
-	int luaTop = lua_gettop(L);
+	[[maybe_unused]] int luaTop = lua_gettop(L);
 	assert(LUA_STACK_TRACK_START == luaTop);
 }
 
@@ -725,7 +1208,7 @@ void LuaScript::registerGlobalFunction(const std::string& name, lua_CFunction fu
 
 void LuaScript::registerStaticMethod(const std::string& className, const std::string& methodName, lua_CFunction method)
 {
-	int top = lua_gettop(m_luaState);
+	[[maybe_unused]] int top = lua_gettop(m_luaState);
 
 	putGlobalOnStack(m_luaState, className);
 	if (!isTable(m_luaState, -1)) {
@@ -762,19 +1245,24 @@ void LuaScript::pushNil(lua_State* L)
 	lua_pushnil(L);
 }
 
-void LuaScript::pushString(lua_State* L, const std::string& value)
+void LuaScript::pushString(lua_State* L, std::string_view value)
 {
-	lua_pushlstring(L, value.c_str(), value.length());
+	lua_pushlstring(L, value.data(), value.length());
 }
 
 std::string LuaScript::getString(lua_State* L, int32_t arg)
+{
+	return std::string(getStringView(L, arg));
+}
+
+std::string_view LuaScript::getStringView(lua_State* L, int32_t arg)
 {
 	size_t len;
 	const char* c_str = lua_tolstring(L, arg, &len);
 	if (!c_str || len == 0) {
-		return std::string();
+		return std::string_view();
 	}
-	return std::string(c_str, len);
+	return std::string_view(c_str, len);
 }
 
 std::string LuaScript::popString(lua_State* L)
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <script/luaallocator.h>
+#include <core/logger.h>
+
+LuaAllocator::LuaAllocator()
+{
+    m_owners.emplace_back();
+    m_owners.back().name = "core";
+}
+
+LuaAllocator::~LuaAllocator()
+{
+    for (void* slab : m_slabs) {
+        free(slab);
+    }
+}
+
+void* LuaAllocator::alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    LuaAllocator* allocator = static_cast<LuaAllocator*>(ud);
+    if (nsize == 0) {
+        if (ptr) {
+            allocator->release(ptr, osize);
+        }
+        return nullptr;
+    }
+
+    if (!ptr) {
+        return allocator->allocate(allocator->m_currentOwner, nsize);
+    }
+    return allocator->reallocate(ptr, osize, nsize);
+}
+
+uint16_t LuaAllocator::registerOwner(const std::string& name)
+{
+    for (size_t owner = 0; owner < m_owners.size(); ++owner) {
+        if (m_owners[owner].name == name) {
+            return static_cast<uint16_t>(owner);
+        }
+    }
+
+    m_owners.emplace_back();
+    m_owners.back().name = name;
+    return static_cast<uint16_t>(m_owners.size() - 1);
+}
+
+uint8_t LuaAllocator::getSizeClass(size_t size)
+{
+    if (size > MAX_POOLED_SIZE) {
+        return UNPOOLED;
+    }
+
+    const size_t blockSize = size + HEADER_SIZE;
+    for (uint8_t sizeClass = 0; sizeClass < SIZE_CLASSES.size(); ++sizeClass) {
+        if (blockSize <= SIZE_CLASSES[sizeClass]) {
+            return sizeClass;
+        }
+    }
+    return UNPOOLED;
+}
+
+void* LuaAllocator::allocate(uint16_t owner, size_t size)
+{
+    if (!canGrow(owner, size)) {
+        return nullptr;
+    }
+
+    BlockHeader* header = allocateBlock(getSizeClass(size), size);
+    if (!header) {
+        return nullptr;
+    }
+
+    header->owner = owner;
+    account(owner, size);
+    ++m_owners[owner].allocations;
+    return reinterpret_cast<uint8_t*>(header) + HEADER_SIZE;
+}
+
+void* LuaAllocator::reallocate(void* ptr, size_t osize, size_t nsize)
+{
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE);
+    const uint16_t owner = header->owner;
+
+    // shrinking must not fail, Lua shrinks during the GC and a NULL is raised
+    // as a memory error; the old block is kept when moving it is not possible
+    const bool shrinking = nsize <= osize;
+    if (!shrinking && !canGrow(owner, nsize - osize)) {
+        return nullptr;
+    }
+
+    const uint8_t sizeClass = getSizeClass(nsize);
+    if (sizeClass == header->sizeClass && sizeClass != UNPOOLED) {
+        // still fits the block
+        account(owner, static_cast<int64_t>(nsize) - static_cast<int64_t>(osize));
+        return ptr;
+    }
+
+    if (sizeClass == UNPOOLED && header->sizeClass == UNPOOLED) {
+        BlockHeader* newHeader = static_cast<BlockHeader*>(realloc(header, nsize + HEADER_SIZE));
+        if (!newHeader) {
+            if (shrinking) {
+                account(owner, static_cast<int64_t>(nsize) - static_cast<int64_t>(osize));
+                return ptr;
+            }
+            return nullptr;
+        }
+
+        account(owner, static_cast<int64_t>(nsize) - static_cast<int64_t>(osize));
+        return reinterpret_cast<uint8_t*>(newHeader) + HEADER_SIZE;
+    }
+
+    BlockHeader* newHeader = allocateBlock(sizeClass, nsize);
+    if (!newHeader) {
+        if (shrinking) {
+            account(owner, static_cast<int64_t>(nsize) - static_cast<int64_t>(osize));
+            return ptr;
+        }
+        return nullptr;
+    }
+
+    newHeader->owner = owner;
+    void* newPtr = reinterpret_cast<uint8_t*>(newHeader) + HEADER_SIZE;
+    memcpy(newPtr, ptr, std::min(osize, nsize));
+
+    releaseBlock(header);
+    account(owner, static_cast<int64_t>(nsize) - static_cast<int64_t>(osize));
+    return newPtr;
+}
+
+void LuaAllocator::release(void* ptr, size_t size)
+{
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE);
+    account(header->owner, -static_cast<int64_t>(size));
+    releaseBlock(header);
+}
+
+LuaAllocator::BlockHeader* LuaAllocator::allocateBlock(uint8_t sizeClass, size_t size)
+{
+    BlockHeader* header = nullptr;
+    if (sizeClass == UNPOOLED) {
+        header = static_cast<BlockHeader*>(malloc(size + HEADER_SIZE));
+        if (!header) {
+            return nullptr;
+        }
+    } else {
+        FreeBlock*& freeList = m_freeLists[sizeClass];
+        if (!freeList) {
+            // carve a new slab into blocks of this class
+            uint8_t* slab = static_cast<uint8_t*>(malloc(SLAB_SIZE));
+            if (!slab) {
+                return nullptr;
+            }
+            m_slabs.push_back(slab);
+
+            const size_t blockSize = SIZE_CLASSES[sizeClass];
+            for (size_t offset = 0; offset + blockSize <= SLAB_SIZE; offset += blockSize) {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + offset);
+                block->next = freeList;
+                freeList = block;
+            }
+        }
+
+        header = reinterpret_cast<BlockHeader*>(freeList);
+        freeList = freeList->next;
+    }
+
+    header->sizeClass = sizeClass;
+    return header;
+}
+
+void LuaAllocator::releaseBlock(BlockHeader* header)
+{
+    if (header->sizeClass == UNPOOLED) {
+        free(header);
+        return;
+    }
+
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+    FreeBlock*& freeList = m_freeLists[header->sizeClass];
+    block->next = freeList;
+    freeList = block;
+}
+
+bool LuaAllocator::canGrow(uint16_t owner, size_t size)
+{
+    if (owner == CORE_OWNER || m_hardLimit == 0) {
+        return true;
+    }
+
+    OwnerStats& stats = m_owners[owner];
+    if (static_cast<size_t>(stats.bytes) + size <= m_hardLimit) {
+        return true;
+    }
+
+    if (stats.failures++ == 0) {
+        g_logger.error("[LuaAllocator] Module {:s} reached the hard memory limit ({:d} KB)", stats.name, m_hardLimit / 1024);
+    }
+    return false;
+}
+
+void LuaAllocator::account(uint16_t owner, int64_t size)
+{
+    OwnerStats& stats = m_owners[owner];
+    stats.bytes += size;
+    if (stats.bytes > stats.peak) {
+        stats.peak = stats.bytes;
+    }
+
+    if (owner == CORE_OWNER || m_softLimit == 0) {
+        return;
+    }
+
+    // reported again only after going back below 90% of the limit
+    if (!stats.overSoftLimit && static_cast<size_t>(stats.bytes) > m_softLimit) {
+        stats.overSoftLimit = true;
+        g_logger.warning("[LuaAllocator] Module {:s} is above the soft memory limit: {:d} KB", stats.name, stats.bytes / 1024);
+    } else if (stats.overSoftLimit && static_cast<size_t>(stats.bytes) < m_softLimit / 10 * 9) {
+        stats.overSoftLimit = false;
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <filesystem>
+#include <fstream>
+#include <fmt/format.h>
+
+#include <script/luaprofiler.h>
+#include <script/lua.h>
+#include <core/module.h>
+#include <core/logger.h>
+
+void LuaProfiler::Histogram::add(uint64_t micros)
+{
+    size_t bucket = 0;
+    while (bucket < BUCKETS - 1 && micros >= (uint64_t(1) << bucket)) {
+        ++bucket;
+    }
+
+    ++buckets[bucket];
+    ++count;
+    totalMicros += micros;
+    maxMicros = std::max(maxMicros, micros);
+}
+
+uint64_t LuaProfiler::Histogram::percentile(double fraction) const
+{
+    const uint64_t target = static_cast<uint64_t>(count * fraction);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += buckets[bucket];
+        if (seen > target) {
+            return std::min(uint64_t(1) << bucket, maxMicros);
+        }
+    }
+    return maxMicros;
+}
+
+void LuaProfiler::start(lua_State* L, uint32_t interval)
+{
+    if (isEnabled()) {
+        return;
+    }
+
+    if (interval != 0) {
+        // "f": function level samples, "i<ms>": interval
+        const std::string mode = fmt::format("fi{:d}", interval);
+        luaJIT_profile_start(L, mode.c_str(), LuaProfiler::sample, this);
+        m_sampling = true;
+    }
+
+    m_enabled.store(true, std::memory_order_relaxed);
+    g_logger.info("[LuaProfiler] Started, sampling {:s}", interval != 0 ? fmt::format("every {:d} ms", interval) : "disabled");
+}
+
+void LuaProfiler::stop(lua_State* L)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    if (m_sampling) {
+        luaJIT_profile_stop(L);
+        m_sampling = false;
+    }
+
+    m_enabled.store(false, std::memory_order_relaxed);
+    g_logger.info("[LuaProfiler] Stopped");
+}
+
+void LuaProfiler::recordCall(Module* module, const std::string& event, const std::string& identifier, std::chrono::steady_clock::duration elapsed)
+{
+    uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_calls[CallKey(module->getName(), event, identifier)].add(micros);
+}
+
+void LuaProfiler::sample(void* data, lua_State* L, int samples, int vmstate)
+{
+    LuaProfiler* profiler = static_cast<LuaProfiler*>(data);
+
+    // root first, "module:function" frames separated by ';'
+    size_t length = 0;
+    const char* stack = luaJIT_profile_dumpstack(L, "FZ;", -64, &length);
+    std::string folded(stack, length);
+    switch (vmstate) {
+        case 'G':
+            folded += ";[gc]";
+            break;
+        case 'J':
+            folded += ";[jit compiler]";
+            break;
+        case 'C':
+            folded += ";[C]";
+            break;
+        default:
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(profiler->m_lock);
+    profiler->m_stacks[folded] += samples;
+    profiler->m_samples += samples;
+}
+
+bool LuaProfiler::dump(const std::string& directory)
+{
+    std::map<CallKey, Histogram> calls;
+    std::unordered_map<std::string, uint64_t> stacks;
+    uint64_t samples;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        calls.swap(m_calls);
+        stacks.swap(m_stacks);
+        samples = m_samples;
+        m_samples = 0;
+    }
+
+    if (calls.empty() && stacks.empty()) {
+        g_logger.info("[LuaProfiler] Nothing collected");
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    const std::string prefix = fmt::format("{:s}/lua-{:d}", directory, std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    std::ofstream latency(prefix + "-latency.txt");
+    latency << fmt::format("{:<16s} {:<32s} {:<24s} {:>10s} {:>10s} {:>10s} {:>10s} {:>10s} {:>10s}\n",
+        "module", "event", "identifier", "calls", "avg(us)", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+    for (const auto& [key, histogram] : calls) {
+        const auto& [module, event, identifier] = key;
+        latency << fmt::format("{:<16s} {:<32s} {:<24s} {:>10d} {:>10d} {:>10d} {:>10d} {:>10d} {:>10d}\n",
+            module, event, identifier.empty() ? "-" : identifier, histogram.count, histogram.totalMicros / histogram.count,
+            histogram.percentile(0.5), histogram.percentile(0.9), histogram.percentile(0.99), histogram.maxMicros);
+    }
+
+    std::ofstream folded(prefix + ".folded");
+    for (const auto& [stack, count] : stacks) {
+        folded << stack << ' ' << count << '\n';
+    }
+
+    if (!latency || !folded) {
+        g_logger.error("[LuaProfiler] Failed to write {:s}", prefix);
+        return false;
+    }
+
+    g_logger.info("[LuaProfiler] {:d} callbacks and {:d} samples written to {:s}", calls.size(), samples, prefix);
+    return true;
+}
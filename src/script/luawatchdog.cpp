@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include "includes.h"
+
+#include <fmt/format.h>
+
+#include <script/luawatchdog.h>
+#include <script/lua.h>
+#include <core/module.h>
+#include <core/modulemanager.h>
+#include <core/logger.h>
+#include <core/tasks.h>
+
+LuaWatchdog::Scope::Scope(LuaWatchdog& watchdog, lua_State* L, Module* module, uint16_t owner, const std::string& event, int32_t callback, const std::string& identifier) :
+    m_watchdog(watchdog), m_L(L), m_module(module), m_owner(owner), m_event(event), m_callback(callback), m_identifier(identifier)
+{
+    if (!watchdog.isEnabled() || watchdog.m_running) {
+        return;
+    }
+
+    m_active = true;
+    watchdog.m_running = true;
+    watchdog.m_exceeded = false;
+    watchdog.m_executed = 0;
+    watchdog.m_deadline = std::chrono::steady_clock::now() + watchdog.m_timeBudget;
+    lua_sethook(L, LuaWatchdog::hook, LUA_MASKCOUNT, watchdog.m_hookInterval);
+}
+
+LuaWatchdog::Scope::~Scope()
+{
+    if (!m_active) {
+        return;
+    }
+
+    lua_sethook(m_L, nullptr, 0, 0);
+    m_watchdog.m_running = false;
+    if (m_watchdog.m_exceeded) {
+        m_watchdog.onViolation(*this);
+    }
+}
+
+void LuaWatchdog::setBudget(uint32_t instructions, uint32_t milliseconds, uint32_t hookInterval, uint32_t maxViolations)
+{
+    m_instructionBudget = instructions;
+    m_timeBudget = std::chrono::milliseconds(milliseconds);
+    m_hookInterval = static_cast<int>(std::max<uint32_t>(hookInterval, 1));
+    m_maxViolations = maxViolations;
+}
+
+void LuaWatchdog::hook(lua_State* L, lua_Debug*)
+{
+    LuaWatchdog& watchdog = g_lua->getWatchdog();
+    if (!watchdog.m_running) {
+        return;
+    }
+
+    if (!watchdog.m_exceeded) {
+        watchdog.m_executed += watchdog.m_hookInterval;
+
+        const bool instructions = watchdog.m_instructionBudget != 0 && watchdog.m_executed > watchdog.m_instructionBudget;
+        const bool time = watchdog.m_timeBudget.count() != 0 && std::chrono::steady_clock::now() > watchdog.m_deadline;
+        if (!instructions && !time) {
+            return;
+        }
+
+        watchdog.m_exceeded = true;
+        const std::string message = instructions ?
+            fmt::format("Callback exceeded its budget of {:d} instructions", watchdog.m_instructionBudget) :
+            fmt::format("Callback exceeded its budget of {:d} ms", watchdog.m_timeBudget.count());
+        luaL_traceback(L, L, message.c_str(), 0);
+        LuaScript::reportError(nullptr, LuaScript::popString(L));
+
+        // from now on every instruction fails, until the callback returned
+        lua_sethook(L, LuaWatchdog::hook, LUA_MASKCOUNT, 1);
+    }
+
+    luaL_error(L, "callback budget exceeded");
+}
+
+void LuaWatchdog::onViolation(const Scope& scope)
+{
+    const std::string name = scope.m_module ? scope.m_module->getName() : g_lua->getAllocator().getOwnerStats(scope.m_owner).name;
+    uint64_t violations = ++m_violations[name];
+
+    if (!scope.m_module) {
+        g_logger.warning("[LuaWatchdog] ({:s}) Coroutine aborted, {:d} violations so far", name, violations);
+        return;
+    }
+
+    uint32_t callbackViolations = ++m_callbackViolations[{scope.m_module, scope.m_callback}];
+    g_logger.warning("[LuaWatchdog] ({:s}) Callback of {:s}{:s} aborted ({:d}/{:d})", name, scope.m_event,
+        scope.m_identifier.empty() ? "" : " [" + scope.m_identifier + "]", callbackViolations, m_maxViolations);
+
+    if (m_maxViolations == 0 || callbackViolations < m_maxViolations) {
+        return;
+    }
+
+    m_callbackViolations.erase({scope.m_module, scope.m_callback});
+    g_logger.error("[LuaWatchdog] ({:s}) Disconnecting the callback of {:s}", name, scope.m_event);
+
+    // not while the emit is still iterating the callbacks
+    g_dispatcher.addTask(createTask([name, module = scope.m_module, event = scope.m_event, callback = scope.m_callback, identifier = scope.m_identifier]() {
+        std::lock_guard<std::recursive_mutex> lock(g_lua->getMutex());
+        // a reload may have replaced and released the version in between
+        if (g_modules->getModuleByName(name) != module) {
+            return;
+        }
+
+        if (identifier.empty()) {
+            module->disconnect(event, callback);
+        } else {
+            module->disconnect(event, identifier);
+        }
+    }));
+}
@@ -7,6 +7,8 @@
 
 #include "includes.h"
 
+#include <fmt/format.h>
+
 #include <utils/tools.h>
 #include <network/networkmessage.h>
 
@@ -169,3 +171,231 @@ std::string demangleName(const char* mangledName) {
     return result;
 #endif
 }
+
+static void skipJsonWhitespace(const std::string& json, size_t& pos)
+{
+    while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) {
+        ++pos;
+    }
+}
+
+// the four hex digits after the 'u' at pos, pos is left on the last one
+static bool parseJsonHex(const std::string& json, size_t& pos, uint32_t& code)
+{
+    if (pos + 4 >= json.size()) {
+        return false;
+    }
+
+    code = 0;
+    for (size_t i = pos + 1; i <= pos + 4; ++i) {
+        const char ch = json[i];
+        if (!std::isxdigit(static_cast<unsigned char>(ch))) {
+            return false;
+        }
+        code = (code << 4) | static_cast<uint32_t>(std::isdigit(static_cast<unsigned char>(ch)) ? ch - '0' : (std::tolower(static_cast<unsigned char>(ch)) - 'a' + 10));
+    }
+    pos += 4;
+    return true;
+}
+
+static void appendUtf8(std::string& value, uint32_t code)
+{
+    if (code < 0x80) {
+        value.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        value.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        value.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        value.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        value.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+static bool parseJsonString(const std::string& json, size_t& pos, std::string& value)
+{
+    if (pos >= json.size() || json[pos] != '"') {
+        return false;
+    }
+
+    value.clear();
+    for (++pos; pos < json.size(); ++pos) {
+        char ch = json[pos];
+        if (ch == '"') {
+            ++pos;
+            return true;
+        }
+
+        if (ch != '\\') {
+            value.push_back(ch);
+            continue;
+        }
+
+        if (++pos >= json.size()) {
+            return false;
+        }
+
+        switch (json[pos]) {
+            case 'b': value.push_back('\b'); break;
+            case 'f': value.push_back('\f'); break;
+            case 'n': value.push_back('\n'); break;
+            case 'r': value.push_back('\r'); break;
+            case 't': value.push_back('\t'); break;
+            case 'u': {
+                uint32_t code = 0;
+                if (!parseJsonHex(json, pos, code)) {
+                    return false;
+                }
+
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    // a high surrogate, the low half follows as a second \u escape
+                    uint32_t low = 0;
+                    size_t next = pos + 2;
+                    if (pos + 2 < json.size() && json[pos + 1] == '\\' && json[pos + 2] == 'u' && parseJsonHex(json, next, low) &&
+                        low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        pos = next;
+                    } else {
+                        code = 0xFFFD;
+                    }
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    code = 0xFFFD;
+                }
+
+                appendUtf8(value, code);
+                break;
+            }
+            default: value.push_back(json[pos]); break;
+        }
+    }
+
+    return false;
+}
+
+static bool skipJsonNested(const std::string& json, size_t& pos)
+{
+    int depth = 0;
+    std::string ignored;
+    while (pos < json.size()) {
+        char ch = json[pos];
+        if (ch == '"') {
+            if (!parseJsonString(json, pos, ignored)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (ch == '{' || ch == '[') {
+            ++depth;
+        } else if (ch == '}' || ch == ']') {
+            if (--depth == 0) {
+                ++pos;
+                return true;
+            }
+        }
+        ++pos;
+    }
+
+    return false;
+}
+
+bool parseJsonObject(const std::string& json, JsonFields& fields)
+{
+    size_t pos = 0;
+    skipJsonWhitespace(json, pos);
+    if (pos >= json.size() || json[pos++] != '{') {
+        return false;
+    }
+
+    std::string key, value;
+    while (true) {
+        skipJsonWhitespace(json, pos);
+        if (pos < json.size() && json[pos] == '}') {
+            return true;
+        }
+
+        if (!parseJsonString(json, pos, key)) {
+            return false;
+        }
+
+        skipJsonWhitespace(json, pos);
+        if (pos >= json.size() || json[pos++] != ':') {
+            return false;
+        }
+
+        skipJsonWhitespace(json, pos);
+        if (pos >= json.size()) {
+            return false;
+        }
+
+        if (json[pos] == '"') {
+            if (!parseJsonString(json, pos, value)) {
+                return false;
+            }
+        } else if (json[pos] == '{' || json[pos] == '[') {
+            size_t start = pos;
+            if (!skipJsonNested(json, pos)) {
+                return false;
+            }
+            value = json.substr(start, pos - start);
+        } else {
+            // numbers, true, false and null
+            size_t start = pos;
+            while (pos < json.size() && json[pos] != ',' && json[pos] != '}' && !std::isspace(static_cast<unsigned char>(json[pos]))) {
+                ++pos;
+            }
+            value = json.substr(start, pos - start);
+        }
+
+        fields[key] = value;
+
+        skipJsonWhitespace(json, pos);
+        if (pos >= json.size()) {
+            return false;
+        }
+
+        if (json[pos] == ',') {
+            ++pos;
+        } else if (json[pos] == '}') {
+            return true;
+        } else {
+            return false;
+        }
+    }
+}
+
+bool isJsonTruthy(const JsonFields& fields, const std::string& key)
+{
+    auto it = fields.find(key);
+    return it != fields.end() && it->second != "false" && it->second != "null";
+}
+
+std::string escapeJsonString(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size() + 2);
+    escaped.push_back('"');
+    for (char ch : value) {
+        switch (ch) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    escaped += fmt::format("\\u{:04x}", static_cast<int>(ch));
+                } else {
+                    escaped.push_back(ch);
+                }
+                break;
+        }
+    }
+    escaped.push_back('"');
+    return escaped;
+}
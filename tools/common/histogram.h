@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef TOOLS_COMMON_HISTOGRAM_H
+#define TOOLS_COMMON_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * Latency histogram of microseconds shared by the client threads, same
+ * log-linear layout as MetricHistogram (4 sub-buckets per power of two).
+ */
+class LatencyHistogram
+{
+    public:
+        static constexpr size_t SUB_BUCKETS = 4;
+        static constexpr size_t MAX_EXPONENT = 32;
+        static constexpr size_t BUCKETS = SUB_BUCKETS + (MAX_EXPONENT - 2) * SUB_BUCKETS;
+
+        void record(uint64_t micros) {
+            m_counts[getBucket(micros)].fetch_add(1, std::memory_order_relaxed);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_sum.fetch_add(micros, std::memory_order_relaxed);
+
+            uint64_t max = m_max.load(std::memory_order_relaxed);
+            while (micros > max && !m_max.compare_exchange_weak(max, micros, std::memory_order_relaxed));
+        }
+
+        uint64_t getCount() const {
+            return m_count.load(std::memory_order_relaxed);
+        }
+        uint64_t getMax() const {
+            return m_max.load(std::memory_order_relaxed);
+        }
+        uint64_t getMean() const {
+            const uint64_t count = getCount();
+            return count != 0 ? m_sum.load(std::memory_order_relaxed) / count : 0;
+        }
+
+        // upper bound of the bucket holding the quantile
+        uint64_t getPercentile(double quantile) const {
+            const uint64_t count = getCount();
+            if (count == 0) {
+                return 0;
+            }
+
+            const uint64_t rank = static_cast<uint64_t>(quantile * (count - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                seen += m_counts[bucket].load(std::memory_order_relaxed);
+                if (seen >= rank) {
+                    return std::min(getUpperBound(bucket), getMax());
+                }
+            }
+            return getMax();
+        }
+
+        void print(FILE* out) const {
+            uint64_t cumulative = 0;
+            const uint64_t count = getCount();
+            std::fprintf(out, "%14s %10s %8s\n", "<= us", "count", "cum %");
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                const uint64_t bucketCount = m_counts[bucket].load(std::memory_order_relaxed);
+                if (bucketCount == 0) {
+                    continue;
+                }
+                cumulative += bucketCount;
+                std::fprintf(out, "%14llu %10llu %7.3f%%\n", static_cast<unsigned long long>(getUpperBound(bucket)),
+                    static_cast<unsigned long long>(bucketCount), 100.0 * cumulative / count);
+            }
+        }
+
+        static size_t getBucket(uint64_t micros) {
+            if (micros < SUB_BUCKETS) {
+                return static_cast<size_t>(micros);
+            }
+
+            size_t exponent = 0;
+            while ((micros >> (exponent + 1)) != 0) {
+                ++exponent;
+            }
+            if (exponent >= MAX_EXPONENT) {
+                return BUCKETS - 1;
+            }
+            return SUB_BUCKETS + (exponent - 2) * SUB_BUCKETS + ((micros >> (exponent - 2)) & (SUB_BUCKETS - 1));
+        }
+
+        static uint64_t getUpperBound(size_t bucket) {
+            if (bucket < SUB_BUCKETS) {
+                return bucket + 1;
+            }
+
+            const size_t exponent = 2 + (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+            const size_t subBucket = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+            return static_cast<uint64_t>(SUB_BUCKETS + subBucket + 1) << (exponent - 2);
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKETS> m_counts{};
+        std::atomic<uint64_t> m_count{0};
+        std::atomic<uint64_t> m_sum{0};
+        std::atomic<uint64_t> m_max{0};
+};
+
+#endif
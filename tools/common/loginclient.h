@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef TOOLS_COMMON_LOGINCLIENT_H
+#define TOOLS_COMMON_LOGINCLIENT_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cryptopp/rsa.h>
+
+/**
+ * Client side of the login protocol for the tools (load generator, replay),
+ * written against the wire format of Protocol and Connection without
+ * linking the server:
+ *
+ *   login:  u16 size, u32 adler32, u8 protocol id, u16 os, u16 version,
+ *           17 signature bytes, 128 RSA bytes (0, XTEA key, email, password)
+ *   later:  u16 size, u32 adler32, XTEA(u16 length, payload, padding)
+ */
+namespace LoginClient
+{
+    enum Opcode : uint8_t {
+        Error = 2,
+        Motd = 3,
+        CharacterList = 4,
+        SessionKey = 5,
+        LoadingMessage = 7,
+        GameServerHost = 8,
+    };
+
+    static constexpr size_t HEADER_LENGTH = 2;
+    static constexpr size_t RSA_BLOCK_SIZE = 128;
+
+    using XteaKey = std::array<uint32_t, 4>;
+
+    class PacketWriter
+    {
+        public:
+            void addU8(uint8_t value) {
+                m_data.push_back(value);
+            }
+            void addU16(uint16_t value) {
+                addBytes(&value, sizeof(value));
+            }
+            void addU32(uint32_t value) {
+                addBytes(&value, sizeof(value));
+            }
+            void addString(const std::string& value) {
+                addU16(static_cast<uint16_t>(value.size()));
+                addBytes(value.data(), value.size());
+            }
+            void addBytes(const void* data, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                m_data.insert(m_data.end(), bytes, bytes + size);
+            }
+
+            const std::vector<uint8_t>& getData() const {
+                return m_data;
+            }
+
+        private:
+            std::vector<uint8_t> m_data;
+    };
+
+    class PacketReader
+    {
+        public:
+            PacketReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+            uint8_t getU8();
+            uint16_t getU16();
+            uint32_t getU32();
+            std::string getString();
+
+            size_t getRemaining() const {
+                return m_size - m_position;
+            }
+
+            // false once a read went past the end
+            bool isValid() const {
+                return m_valid;
+            }
+
+        private:
+            bool canRead(size_t size);
+
+            const uint8_t* m_data;
+            size_t m_size;
+            size_t m_position = 0;
+            bool m_valid = true;
+    };
+
+    struct Character {
+        std::string name;
+        std::string instanceName;
+        std::string instanceId;
+        uint16_t level = 0;
+        bool autoReconnect = false;
+    };
+
+    // everything the server sent so far, filled by parseMessages
+    struct ServerReply {
+        std::string error;
+        std::string motd;
+        std::string sessionKey;
+        std::vector<std::string> loadingMessages;
+
+        bool hasCharacterList = false;
+        std::vector<Character> characters;
+        bool premium = false;
+        uint32_t premiumEnd = 0;
+
+        bool hasGameServerHost = false;
+        std::string gameServerHost;
+        uint16_t gameServerPort = 0;
+    };
+
+    // public half of the server key (the private key.pem the server loads)
+    class PublicKey
+    {
+        public:
+            // throws std::runtime_error
+            void loadPEM(const std::string& path);
+
+            // raw RSA on one big-endian block, the inverse of RSA::decrypt
+            void encrypt(uint8_t* block) const;
+
+        private:
+            CryptoPP::RSA::PublicKey m_key;
+    };
+
+    uint32_t adlerChecksum(const uint8_t* data, size_t length);
+
+    void xteaEncrypt(const XteaKey& key, uint8_t* data, size_t size);
+    void xteaDecrypt(const XteaKey& key, uint8_t* data, size_t size);
+
+    XteaKey generateKey();
+
+    // complete first packet, size header included
+    std::vector<uint8_t> buildLoginPacket(const PublicKey& publicKey, const XteaKey& key, uint16_t version, const std::string& email, const std::string& password);
+
+    // complete XTEA packet of the payload (opcode and fields), size header included
+    std::vector<uint8_t> buildPacket(const XteaKey& key, const std::vector<uint8_t>& payload);
+
+    std::vector<uint8_t> buildGameServerHostRequest(const XteaKey& key, const std::string& instanceName, const std::string& instanceId);
+
+    // body of a server packet (without the size header) decrypted in place,
+    // false when it is malformed; payload points at the messages
+    bool decryptPacket(const XteaKey& key, std::vector<uint8_t>& body, const uint8_t*& payload, size_t& payloadSize);
+
+    // false on an unknown opcode or a truncated message
+    bool parseMessages(const uint8_t* payload, size_t size, ServerReply& reply);
+}
+
+#endif
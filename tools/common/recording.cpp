@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <common/recording.h>
+
+namespace Recording
+{
+    namespace
+    {
+        constexpr uint8_t FORMAT_VERSION = 1;
+
+        // TrafficRecorder::RecordType
+        enum RecordType : uint8_t {
+            LoginRecord = 1,
+            PacketRecord = 2,
+            CloseRecord = 3,
+        };
+
+        class Reader
+        {
+            public:
+                explicit Reader(std::vector<uint8_t> data) : m_data(std::move(data)) {}
+
+                bool atEnd() const {
+                    return m_position == m_data.size();
+                }
+
+                uint8_t getU8() {
+                    require(1);
+                    return m_data[m_position++];
+                }
+
+                uint64_t getVarint() {
+                    uint64_t value = 0;
+                    for (uint32_t shift = 0; shift < 64; shift += 7) {
+                        const uint8_t byte = getU8();
+                        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0) {
+                            return value;
+                        }
+                    }
+                    throw std::runtime_error("invalid varint");
+                }
+
+                const uint8_t* getBytes(size_t size) {
+                    require(size);
+                    const uint8_t* bytes = m_data.data() + m_position;
+                    m_position += size;
+                    return bytes;
+                }
+
+            private:
+                void require(size_t size) const {
+                    if (m_data.size() - m_position < size) {
+                        throw std::runtime_error("truncated record");
+                    }
+                }
+
+                std::vector<uint8_t> m_data;
+                size_t m_position = 0;
+        };
+
+        template<typename T>
+        T readInteger(const uint8_t*& data)
+        {
+            T value = 0;
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                value |= static_cast<T>(static_cast<T>(*data++) << (8 * i));
+            }
+            return value;
+        }
+    }
+
+    Recording load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Missing file " + path);
+        }
+
+        Reader reader{std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>())};
+        const uint8_t* magic = reader.getBytes(4);
+        if (memcmp(magic, "PWOR", 4) != 0 || reader.getU8() != FORMAT_VERSION) {
+            throw std::runtime_error(path + " is not a traffic recording of this format version");
+        }
+
+        Recording recording;
+        std::unordered_map<uint64_t, size_t> open;
+        uint64_t time = 0;
+        while (!reader.atEnd()) {
+            const uint8_t type = reader.getU8();
+            const uint64_t connectionId = reader.getVarint();
+            time += reader.getVarint();
+            const size_t size = reader.getVarint();
+            const uint8_t* data = reader.getBytes(size);
+            ++recording.records;
+
+            if (type == LoginRecord) {
+                // version, key, email length
+                if (size < 2 + 16 + 2) {
+                    throw std::runtime_error("truncated login record");
+                }
+
+                Session session;
+                session.connectionId = connectionId;
+                session.loginTime = time;
+                session.version = readInteger<uint16_t>(data);
+                for (uint32_t& part : session.key) {
+                    part = readInteger<uint32_t>(data);
+                }
+                const uint16_t emailLength = readInteger<uint16_t>(data);
+                if (emailLength > size - 20) {
+                    throw std::runtime_error("truncated login record");
+                }
+                session.email.assign(reinterpret_cast<const char*>(data), emailLength);
+
+                open[connectionId] = recording.sessions.size();
+                recording.sessions.push_back(std::move(session));
+                continue;
+            }
+
+            auto it = open.find(connectionId);
+            if (it == open.end()) {
+                ++recording.skippedRecords;
+                continue;
+            }
+
+            Session& session = recording.sessions[it->second];
+            if (type == PacketRecord) {
+                session.packets.push_back({time, std::vector<uint8_t>(data, data + size)});
+            } else if (type == CloseRecord) {
+                session.closed = true;
+                session.closeTime = time;
+                open.erase(it);
+            }
+        }
+
+        recording.duration = time;
+        return recording;
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+#ifndef TOOLS_COMMON_RECORDING_H
+#define TOOLS_COMMON_RECORDING_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <common/loginclient.h>
+
+/**
+ * Reader of the traffic recordings written by the server (TrafficRecorder,
+ * include/network/trafficrecorder.h), grouped into one session per
+ * connection. Times are microseconds since the first record.
+ */
+namespace Recording
+{
+    struct Packet {
+        uint64_t time = 0;
+        std::vector<uint8_t> payload; // opcode first
+    };
+
+    struct Session {
+        uint64_t connectionId = 0;
+        uint64_t loginTime = 0;
+        uint16_t version = 0;
+        LoginClient::XteaKey key{};
+        std::string email;
+        std::vector<Packet> packets;
+        bool closed = false;
+        uint64_t closeTime = 0;
+    };
+
+    struct Recording {
+        std::vector<Session> sessions; // by login time
+        uint64_t duration = 0;
+        uint64_t records = 0;
+        uint64_t skippedRecords = 0; // connections opened before the recording started
+    };
+
+    // throws std::runtime_error on a missing file, a wrong header or a truncated record
+    Recording load(const std::string& path);
+}
+
+#endif
@@ -0,0 +1,527 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+/**
+ * Login load generator. Every simulated client connects, logs in with the
+ * real handshake, waits for the character list and optionally asks for the
+ * game server of its first character (GameServerHost opcode).
+ *
+ *   loadgen --accounts accounts.txt [--host 127.0.0.1] [--port 7171]
+ *           [--clients 100] [--rate 0] [--duration 10] [--threads 1]
+ *           [--key key.pem] [--version 100] [--timeout 10] [--game-server-host]
+ *
+ * Closed loop (--rate 0): --clients sessions run back to back. Open loop:
+ * --rate logins per second are started on schedule, at most --clients at
+ * once, late starts are counted as skipped.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <common/histogram.h>
+#include <common/loginclient.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string host = "127.0.0.1";
+        uint16_t port = 7171;
+        uint32_t clients = 100;
+        double rate = 0;
+        uint32_t duration = 10;
+        uint32_t threads = 1;
+        uint32_t timeout = 10;
+        uint16_t version = 100;
+        std::string keyFile = "key.pem";
+        std::string accountsFile;
+        bool gameServerHost = false;
+    };
+
+    struct Account {
+        std::string email;
+        std::string password;
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> started{0};
+        std::atomic<uint64_t> succeeded{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> connectFailed{0};
+        std::atomic<uint64_t> networkErrors{0};
+        std::atomic<uint64_t> protocolErrors{0};
+        std::atomic<uint64_t> timeouts{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> hostAnswers{0};
+        std::atomic<uint64_t> hostTimeouts{0};
+        std::atomic<uint32_t> active{0};
+
+        LatencyHistogram loginLatency;
+        LatencyHistogram hostLatency;
+    };
+
+    enum class Outcome {
+        Success,
+        Rejected,
+        ConnectFailed,
+        NetworkError,
+        ProtocolError,
+        Timeout,
+    };
+
+    uint64_t elapsedMicros(Clock::time_point since)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - since).count());
+    }
+
+    class Session : public std::enable_shared_from_this<Session>
+    {
+        public:
+            using Callback = std::function<void()>;
+
+            Session(boost::asio::io_context& ioContext, const Options& options, const LoginClient::PublicKey& publicKey, Stats& stats) :
+                m_strand(boost::asio::make_strand(ioContext)),
+                m_socket(m_strand),
+                m_timer(m_strand),
+                m_options(options),
+                m_publicKey(publicKey),
+                m_stats(stats) {}
+
+            void start(const boost::asio::ip::tcp::endpoint& endpoint, const Account& account, Callback onDone) {
+                m_onDone = std::move(onDone);
+                m_start = Clock::now();
+                m_key = LoginClient::generateKey();
+                m_packet = LoginClient::buildLoginPacket(m_publicKey, m_key, m_options.version, account.email, account.password);
+
+                m_timer.expires_after(std::chrono::seconds(m_options.timeout));
+                m_timer.async_wait([self = shared_from_this()](const boost::system::error_code& error) {
+                    if (!error) {
+                        self->m_timedOut = true;
+                        boost::system::error_code ignored;
+                        self->m_socket.close(ignored);
+                    }
+                });
+
+                m_socket.async_connect(endpoint, [self = shared_from_this()](const boost::system::error_code& error) {
+                    if (error) {
+                        self->finish(self->m_timedOut ? Outcome::Timeout : Outcome::ConnectFailed);
+                        return;
+                    }
+
+                    boost::system::error_code ignored;
+                    self->m_socket.set_option(boost::asio::ip::tcp::no_delay(true), ignored);
+                    self->send();
+                });
+            }
+
+        private:
+            void send() {
+                boost::asio::async_write(m_socket, boost::asio::buffer(m_packet), [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                    if (error) {
+                        self->finish(self->m_timedOut ? Outcome::Timeout : Outcome::NetworkError);
+                        return;
+                    }
+                    self->readHeader();
+                });
+            }
+
+            void readHeader() {
+                boost::asio::async_read(m_socket, boost::asio::buffer(m_header), [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                    if (error) {
+                        self->finish(self->m_timedOut ? Outcome::Timeout : Outcome::NetworkError);
+                        return;
+                    }
+
+                    const uint16_t size = static_cast<uint16_t>(self->m_header[0] | self->m_header[1] << 8);
+                    self->m_body.resize(size);
+                    self->readBody();
+                });
+            }
+
+            void readBody() {
+                boost::asio::async_read(m_socket, boost::asio::buffer(m_body), [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                    if (error) {
+                        self->finish(self->m_timedOut ? Outcome::Timeout : Outcome::NetworkError);
+                        return;
+                    }
+                    self->onPacket();
+                });
+            }
+
+            void onPacket() {
+                const uint8_t* payload;
+                size_t payloadSize;
+                if (!LoginClient::decryptPacket(m_key, m_body, payload, payloadSize) || !LoginClient::parseMessages(payload, payloadSize, m_reply)) {
+                    finish(Outcome::ProtocolError);
+                    return;
+                }
+
+                if (!m_reply.error.empty()) {
+                    finish(Outcome::Rejected);
+                    return;
+                }
+
+                if (m_loggedIn) {
+                    if (m_reply.hasGameServerHost) {
+                        m_stats.hostAnswers.fetch_add(1, std::memory_order_relaxed);
+                        m_stats.hostLatency.record(elapsedMicros(m_hostStart));
+                        finish(Outcome::Success);
+                        return;
+                    }
+                } else if (m_reply.hasCharacterList) {
+                    m_loggedIn = true;
+                    m_stats.loginLatency.record(elapsedMicros(m_start));
+
+                    if (!m_options.gameServerHost || m_reply.characters.empty()) {
+                        finish(Outcome::Success);
+                        return;
+                    }
+
+                    const LoginClient::Character& character = m_reply.characters.front();
+                    m_packet = LoginClient::buildGameServerHostRequest(m_key, character.instanceName, character.instanceId);
+                    m_hostStart = Clock::now();
+                    send();
+                    return;
+                }
+
+                // loading messages or other traffic before the answer
+                readHeader();
+            }
+
+            void finish(Outcome outcome) {
+                if (m_finished) {
+                    return;
+                }
+                m_finished = true;
+
+                // the login itself succeeded, only the opcode went unanswered
+                if (m_loggedIn && outcome != Outcome::Success) {
+                    m_stats.hostTimeouts.fetch_add(1, std::memory_order_relaxed);
+                    outcome = Outcome::Success;
+                }
+
+                switch (outcome) {
+                    case Outcome::Success: m_stats.succeeded.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::Rejected: m_stats.rejected.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::ConnectFailed: m_stats.connectFailed.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::NetworkError: m_stats.networkErrors.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::ProtocolError: m_stats.protocolErrors.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::Timeout: m_stats.timeouts.fetch_add(1, std::memory_order_relaxed); break;
+                }
+
+                m_timer.cancel();
+                boost::system::error_code ignored;
+                m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                m_socket.close(ignored);
+
+                if (m_onDone) {
+                    m_onDone();
+                }
+            }
+
+            boost::asio::strand<boost::asio::io_context::executor_type> m_strand;
+            boost::asio::ip::tcp::socket m_socket;
+            boost::asio::steady_timer m_timer;
+
+            const Options& m_options;
+            const LoginClient::PublicKey& m_publicKey;
+            Stats& m_stats;
+
+            LoginClient::XteaKey m_key{};
+            std::vector<uint8_t> m_packet;
+            std::array<uint8_t, LoginClient::HEADER_LENGTH> m_header{};
+            std::vector<uint8_t> m_body;
+            LoginClient::ServerReply m_reply;
+
+            Clock::time_point m_start;
+            Clock::time_point m_hostStart;
+            bool m_loggedIn = false;
+            bool m_timedOut = false;
+            bool m_finished = false;
+            Callback m_onDone;
+    };
+
+    class LoadGenerator
+    {
+        public:
+            LoadGenerator(const Options& options, std::vector<Account> accounts) :
+                m_options(options),
+                m_accounts(std::move(accounts)),
+                m_work(boost::asio::make_work_guard(m_ioContext)),
+                m_rateTimer(m_ioContext) {}
+
+            bool init() {
+                try {
+                    m_publicKey.loadPEM(m_options.keyFile);
+                } catch (const std::exception& e) {
+                    std::cerr << "Failed to load " << m_options.keyFile << ": " << e.what() << std::endl;
+                    return false;
+                }
+
+                boost::system::error_code error;
+                m_endpoint = boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(m_options.host, error), m_options.port);
+                if (error) {
+                    std::cerr << "Invalid host " << m_options.host << ": " << error.message() << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+            void run() {
+                m_start = Clock::now();
+                m_deadline = m_start + std::chrono::seconds(m_options.duration);
+
+                if (m_options.rate > 0) {
+                    scheduleOpenLoop();
+                } else {
+                    for (uint32_t i = 0; i < m_options.clients; ++i) {
+                        startSession();
+                    }
+                }
+
+                std::vector<std::thread> threads;
+                for (uint32_t i = 0; i < std::max<uint32_t>(m_options.threads, 1); ++i) {
+                    threads.emplace_back([this]() { m_ioContext.run(); });
+                }
+
+                reportProgress();
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+                m_elapsed = std::chrono::duration<double>(Clock::now() - m_start).count();
+            }
+
+            void printReport() const {
+                const uint64_t succeeded = m_stats.succeeded.load();
+                std::printf("\n%llu logins in %.2f s, %.1f logins/s\n", static_cast<unsigned long long>(succeeded), m_elapsed, succeeded / m_elapsed);
+                std::printf("started %llu, rejected %llu, connect failed %llu, network errors %llu, protocol errors %llu, timeouts %llu, skipped %llu\n",
+                    ull(m_stats.started), ull(m_stats.rejected), ull(m_stats.connectFailed), ull(m_stats.networkErrors),
+                    ull(m_stats.protocolErrors), ull(m_stats.timeouts), ull(m_stats.skipped));
+
+                printLatency("login", m_stats.loginLatency);
+                if (m_options.gameServerHost) {
+                    std::printf("game server host: %llu answered, %llu unanswered\n", ull(m_stats.hostAnswers), ull(m_stats.hostTimeouts));
+                    printLatency("game server host", m_stats.hostLatency);
+                }
+
+                std::printf("\nlogin latency histogram\n");
+                m_stats.loginLatency.print(stdout);
+            }
+
+        private:
+            static unsigned long long ull(const std::atomic<uint64_t>& value) {
+                return static_cast<unsigned long long>(value.load());
+            }
+
+            static void printLatency(const char* name, const LatencyHistogram& histogram) {
+                std::printf("%s latency (us): mean %llu, p50 %llu, p90 %llu, p99 %llu, p99.9 %llu, max %llu\n", name,
+                    static_cast<unsigned long long>(histogram.getMean()), static_cast<unsigned long long>(histogram.getPercentile(0.5)),
+                    static_cast<unsigned long long>(histogram.getPercentile(0.9)), static_cast<unsigned long long>(histogram.getPercentile(0.99)),
+                    static_cast<unsigned long long>(histogram.getPercentile(0.999)), static_cast<unsigned long long>(histogram.getMax()));
+            }
+
+            bool isRunning() const {
+                return Clock::now() < m_deadline;
+            }
+
+            void startSession() {
+                const Account& account = m_accounts[m_nextAccount.fetch_add(1, std::memory_order_relaxed) % m_accounts.size()];
+                m_stats.started.fetch_add(1, std::memory_order_relaxed);
+                m_stats.active.fetch_add(1, std::memory_order_relaxed);
+
+                auto session = std::make_shared<Session>(m_ioContext, m_options, m_publicKey, m_stats);
+                session->start(m_endpoint, account, [this]() {
+                    onSessionDone();
+                });
+            }
+
+            void onSessionDone() {
+                const uint32_t active = m_stats.active.fetch_sub(1, std::memory_order_relaxed) - 1;
+                if (m_options.rate == 0 && isRunning()) {
+                    // closed loop: the next login takes the place of this one
+                    boost::asio::post(m_ioContext, [this]() { startSession(); });
+                } else if (active == 0 && !isRunning()) {
+                    stop();
+                }
+            }
+
+            void scheduleOpenLoop() {
+                m_rateTimer.expires_after(std::chrono::milliseconds(1));
+                m_rateTimer.async_wait([this](const boost::system::error_code& error) {
+                    if (error) {
+                        return;
+                    }
+
+                    if (!isRunning()) {
+                        if (m_stats.active.load() == 0) {
+                            stop();
+                        }
+                        return;
+                    }
+
+                    // every login due by now, so a slow tick does not lower the rate
+                    const double elapsed = std::chrono::duration<double>(Clock::now() - m_start).count();
+                    const uint64_t due = static_cast<uint64_t>(elapsed * m_options.rate);
+                    while (m_scheduled < due) {
+                        ++m_scheduled;
+                        if (m_stats.active.load(std::memory_order_relaxed) >= m_options.clients) {
+                            m_stats.skipped.fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            startSession();
+                        }
+                    }
+                    scheduleOpenLoop();
+                });
+            }
+
+            void reportProgress() {
+                uint64_t last = 0;
+                while (isRunning()) {
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                    const uint64_t succeeded = m_stats.succeeded.load();
+                    std::printf("%llu logins/s, %u active, %llu failed, p99 %llu us\n", static_cast<unsigned long long>(succeeded - last),
+                        m_stats.active.load(), static_cast<unsigned long long>(m_stats.started.load() - succeeded - m_stats.active.load()),
+                        static_cast<unsigned long long>(m_stats.loginLatency.getPercentile(0.99)));
+                    std::fflush(stdout);
+                    last = succeeded;
+                }
+
+                // closed loop with nothing running anymore
+                boost::asio::post(m_ioContext, [this]() {
+                    if (m_stats.active.load() == 0) {
+                        stop();
+                    }
+                });
+            }
+
+            // lets run() return once the last session is done
+            void stop() {
+                std::call_once(m_stopped, [this]() { m_work.reset(); });
+            }
+
+            const Options& m_options;
+            std::vector<Account> m_accounts;
+            std::atomic<uint64_t> m_nextAccount{0};
+
+            boost::asio::io_context m_ioContext;
+            boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+            std::once_flag m_stopped;
+            boost::asio::steady_timer m_rateTimer;
+            boost::asio::ip::tcp::endpoint m_endpoint;
+            LoginClient::PublicKey m_publicKey;
+
+            Stats m_stats;
+            uint64_t m_scheduled = 0;
+            Clock::time_point m_start;
+            Clock::time_point m_deadline;
+            double m_elapsed = 0;
+    };
+
+    // email:password per line
+    std::vector<Account> loadAccounts(const std::string& path)
+    {
+        std::vector<Account> accounts;
+        std::ifstream file(path);
+        for (std::string line; std::getline(file, line);) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+
+            const size_t separator = line.find(':');
+            if (line.empty() || line[0] == '#' || separator == std::string::npos) {
+                continue;
+            }
+            accounts.push_back({line.substr(0, separator), line.substr(separator + 1)});
+        }
+        return accounts;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const std::string name = argv[i];
+            if (name == "--game-server-host") {
+                options.gameServerHost = true;
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << name << std::endl;
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (name == "--host") {
+                options.host = value;
+            } else if (name == "--port") {
+                options.port = static_cast<uint16_t>(std::stoul(value));
+            } else if (name == "--clients") {
+                options.clients = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--rate") {
+                options.rate = std::stod(value);
+            } else if (name == "--duration") {
+                options.duration = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--threads") {
+                options.threads = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--timeout") {
+                options.timeout = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--version") {
+                options.version = static_cast<uint16_t>(std::stoul(value));
+            } else if (name == "--key") {
+                options.keyFile = value;
+            } else if (name == "--accounts") {
+                options.accountsFile = value;
+            } else {
+                std::cerr << "Unknown option " << name << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid option value: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<Account> accounts = loadAccounts(options.accountsFile);
+    if (accounts.empty()) {
+        std::cerr << "No accounts, pass --accounts with one email:password per line" << std::endl;
+        return 1;
+    }
+
+    LoadGenerator generator(options, std::move(accounts));
+    if (!generator.init()) {
+        return 1;
+    }
+
+    std::printf("%s loop against %s:%u, %u clients%s, %u s\n", options.rate > 0 ? "open" : "closed", options.host.c_str(), options.port,
+        options.clients, options.rate > 0 ? (" at " + std::to_string(options.rate) + " logins/s").c_str() : "", options.duration);
+    generator.run();
+    generator.printReport();
+    return 0;
+}
@@ -0,0 +1,665 @@
+/**
+ * Copyright (c) 2025 PWO Team. All rights reserved.
+ * This code is confidential and intended solely for internal use by authorized personnel.
+ * Any unauthorized reproduction, distribution, or disclosure — including publication or sharing outside the company —
+ * is strictly prohibited and may result in legal action.
+ */
+
+/**
+ * Replays a traffic recording (trafficRecord in config.lua) against a
+ * server: every recorded connection logs in again with its recorded XTEA
+ * key and client version and sends its packets on the recorded schedule.
+ *
+ *   replay --recording recordings/recording-<time>.bin [--host 127.0.0.1]
+ *          [--port 7171] [--speed 1] [--threads 1] [--key key.pem]
+ *          [--password replay] [--timeout 10] [--linger 1000]
+ *          [--central 127.0.0.1:6379] [--game-server 127.0.0.1:7172]
+ *   replay --recording <file> --write-accounts accounts.tsv [--password replay]
+ *
+ * Recordings hold no passwords, so the server runs against stand-in
+ * backends: --write-accounts writes an accountStore = "memory" file where
+ * every recorded email logs in with --password, and --central answers the
+ * central_login requests of the server (game-server-host) on its redis
+ * with --game-server. --speed 2 replays twice as fast, 0 without waiting.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <hiredis/hiredis.h>
+
+#include <common/histogram.h>
+#include <common/loginclient.h>
+#include <common/recording.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string recordingFile;
+        std::string host = "127.0.0.1";
+        uint16_t port = 7171;
+        double speed = 1;
+        uint32_t threads = 1;
+        uint32_t timeout = 10;
+        uint32_t linger = 1000;
+        std::string keyFile = "key.pem";
+        std::string password = "replay";
+        std::string accountsFile;
+        std::string central;
+        std::string gameServer = "127.0.0.1:7172";
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> started{0};
+        std::atomic<uint64_t> loggedIn{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> connectFailed{0};
+        std::atomic<uint64_t> networkErrors{0};
+        std::atomic<uint64_t> protocolErrors{0};
+        std::atomic<uint64_t> timeouts{0};
+        std::atomic<uint64_t> packetsSent{0};
+        std::atomic<uint64_t> packetsReceived{0};
+        std::atomic<uint64_t> centralAnswers{0};
+        std::array<std::atomic<uint64_t>, 256> opcodes{};
+        std::atomic<uint32_t> active{0};
+
+        LatencyHistogram loginLatency;
+        // how late packets left against the recorded schedule
+        LatencyHistogram sendLag;
+    };
+
+    enum class Outcome {
+        Done,
+        Rejected,
+        ConnectFailed,
+        NetworkError,
+        ProtocolError,
+        Timeout,
+    };
+
+    uint64_t elapsedMicros(Clock::time_point since)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - since).count());
+    }
+
+    bool splitAddress(const std::string& address, std::string& host, uint16_t& port)
+    {
+        const size_t separator = address.rfind(':');
+        if (separator == std::string::npos) {
+            return false;
+        }
+        host = address.substr(0, separator);
+        port = static_cast<uint16_t>(std::stoul(address.substr(separator + 1)));
+        return true;
+    }
+
+    class ReplaySession : public std::enable_shared_from_this<ReplaySession>
+    {
+        public:
+            using Callback = std::function<void()>;
+
+            ReplaySession(boost::asio::io_context& ioContext, const Options& options, const LoginClient::PublicKey& publicKey, Stats& stats,
+                const Recording::Session& recorded, Clock::time_point origin) :
+                m_strand(boost::asio::make_strand(ioContext)),
+                m_socket(m_strand),
+                m_timer(m_strand),
+                m_loginTimer(m_strand),
+                m_options(options),
+                m_publicKey(publicKey),
+                m_stats(stats),
+                m_recorded(recorded),
+                m_origin(origin) {}
+
+            void start(const boost::asio::ip::tcp::endpoint& endpoint, Callback onDone) {
+                m_onDone = std::move(onDone);
+                m_packet = LoginClient::buildLoginPacket(m_publicKey, m_recorded.key, m_recorded.version, m_recorded.email, m_options.password);
+
+                m_loginTimer.expires_after(std::chrono::seconds(m_options.timeout));
+                m_loginTimer.async_wait([self = shared_from_this()](const boost::system::error_code& error) {
+                    if (!error) {
+                        self->m_timedOut = true;
+                        boost::system::error_code ignored;
+                        self->m_socket.close(ignored);
+                    }
+                });
+
+                m_socket.async_connect(endpoint, [self = shared_from_this()](const boost::system::error_code& error) {
+                    if (error) {
+                        self->finish(self->m_timedOut ? Outcome::Timeout : Outcome::ConnectFailed);
+                        return;
+                    }
+
+                    boost::system::error_code ignored;
+                    self->m_socket.set_option(boost::asio::ip::tcp::no_delay(true), ignored);
+                    self->m_loginStart = Clock::now();
+                    self->write();
+                    self->readHeader();
+                });
+            }
+
+        private:
+            Clock::time_point getDue(uint64_t time) const {
+                if (m_options.speed <= 0) {
+                    return Clock::now();
+                }
+                return m_origin + std::chrono::microseconds(static_cast<uint64_t>(time / m_options.speed));
+            }
+
+            void write() {
+                boost::asio::async_write(m_socket, boost::asio::buffer(m_packet), [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                    if (error) {
+                        self->finish(self->m_timedOut ? Outcome::Timeout : Outcome::NetworkError);
+                        return;
+                    }
+
+                    if (self->m_loggedIn) {
+                        self->scheduleNext();
+                    }
+                });
+            }
+
+            void readHeader() {
+                boost::asio::async_read(m_socket, boost::asio::buffer(m_header), [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                    if (error) {
+                        self->onReadError();
+                        return;
+                    }
+
+                    const uint16_t size = static_cast<uint16_t>(self->m_header[0] | self->m_header[1] << 8);
+                    self->m_body.resize(size);
+                    self->readBody();
+                });
+            }
+
+            void readBody() {
+                boost::asio::async_read(m_socket, boost::asio::buffer(m_body), [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                    if (error) {
+                        self->onReadError();
+                        return;
+                    }
+                    self->onPacket();
+                });
+            }
+
+            void onReadError() {
+                // the server closing a session that is done with its packets is expected
+                finish(m_timedOut ? Outcome::Timeout : m_loggedIn && m_next == m_recorded.packets.size() ? Outcome::Done : Outcome::NetworkError);
+            }
+
+            void onPacket() {
+                const uint8_t* payload;
+                size_t payloadSize;
+                LoginClient::ServerReply reply;
+                if (!LoginClient::decryptPacket(m_recorded.key, m_body, payload, payloadSize) || !LoginClient::parseMessages(payload, payloadSize, reply)) {
+                    finish(Outcome::ProtocolError);
+                    return;
+                }
+                m_stats.packetsReceived.fetch_add(1, std::memory_order_relaxed);
+
+                if (!m_loggedIn) {
+                    if (!reply.error.empty()) {
+                        finish(Outcome::Rejected);
+                        return;
+                    }
+
+                    if (reply.hasCharacterList) {
+                        m_loggedIn = true;
+                        m_loginTimer.cancel();
+                        m_stats.loggedIn.fetch_add(1, std::memory_order_relaxed);
+                        m_stats.loginLatency.record(elapsedMicros(m_loginStart));
+                        scheduleNext();
+                    }
+                }
+                readHeader();
+            }
+
+            // the next recorded packet, then the recorded close
+            void scheduleNext() {
+                if (m_next == m_recorded.packets.size()) {
+                    const Clock::time_point end = m_recorded.closed ? getDue(m_recorded.closeTime) : Clock::now() + std::chrono::milliseconds(m_options.linger);
+                    m_timer.expires_at(end);
+                    m_timer.async_wait([self = shared_from_this()](const boost::system::error_code& error) {
+                        if (!error) {
+                            self->finish(Outcome::Done);
+                        }
+                    });
+                    return;
+                }
+
+                const Recording::Packet& packet = m_recorded.packets[m_next];
+                const Clock::time_point due = getDue(packet.time);
+                m_timer.expires_at(due);
+                m_timer.async_wait([self = shared_from_this(), &packet, due](const boost::system::error_code& error) {
+                    if (error) {
+                        return;
+                    }
+
+                    const Clock::time_point now = Clock::now();
+                    self->m_stats.sendLag.record(now > due ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - due).count()) : 0);
+                    self->m_stats.packetsSent.fetch_add(1, std::memory_order_relaxed);
+                    if (!packet.payload.empty()) {
+                        self->m_stats.opcodes[packet.payload[0]].fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    ++self->m_next;
+                    self->m_packet = LoginClient::buildPacket(self->m_recorded.key, packet.payload);
+                    self->write();
+                });
+            }
+
+            void finish(Outcome outcome) {
+                if (m_finished) {
+                    return;
+                }
+                m_finished = true;
+
+                switch (outcome) {
+                    case Outcome::Done: break;
+                    case Outcome::Rejected: m_stats.rejected.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::ConnectFailed: m_stats.connectFailed.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::NetworkError: m_stats.networkErrors.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::ProtocolError: m_stats.protocolErrors.fetch_add(1, std::memory_order_relaxed); break;
+                    case Outcome::Timeout: m_stats.timeouts.fetch_add(1, std::memory_order_relaxed); break;
+                }
+
+                m_timer.cancel();
+                m_loginTimer.cancel();
+                boost::system::error_code ignored;
+                m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                m_socket.close(ignored);
+
+                if (m_onDone) {
+                    m_onDone();
+                }
+            }
+
+            boost::asio::strand<boost::asio::io_context::executor_type> m_strand;
+            boost::asio::ip::tcp::socket m_socket;
+            boost::asio::steady_timer m_timer;
+            boost::asio::steady_timer m_loginTimer;
+
+            const Options& m_options;
+            const LoginClient::PublicKey& m_publicKey;
+            Stats& m_stats;
+            const Recording::Session& m_recorded;
+            const Clock::time_point m_origin;
+
+            std::vector<uint8_t> m_packet;
+            std::array<uint8_t, LoginClient::HEADER_LENGTH> m_header{};
+            std::vector<uint8_t> m_body;
+
+            Clock::time_point m_loginStart;
+            size_t m_next = 0;
+            bool m_loggedIn = false;
+            bool m_timedOut = false;
+            bool m_finished = false;
+            Callback m_onDone;
+    };
+
+    class Replayer
+    {
+        public:
+            Replayer(const Options& options, Recording::Recording recording) :
+                m_options(options),
+                m_recording(std::move(recording)),
+                m_work(boost::asio::make_work_guard(m_ioContext)),
+                m_launchTimer(m_ioContext) {}
+
+            bool init() {
+                try {
+                    m_publicKey.loadPEM(m_options.keyFile);
+                } catch (const std::exception& e) {
+                    std::cerr << "Failed to load " << m_options.keyFile << ": " << e.what() << std::endl;
+                    return false;
+                }
+
+                boost::system::error_code error;
+                m_endpoint = boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(m_options.host, error), m_options.port);
+                if (error) {
+                    std::cerr << "Invalid host " << m_options.host << ": " << error.message() << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+            void run() {
+                m_start = Clock::now();
+                // the first login is due right away
+                const uint64_t first = m_recording.sessions.empty() ? 0 : m_recording.sessions.front().loginTime;
+                m_origin = m_start - (m_options.speed > 0 ? std::chrono::microseconds(static_cast<uint64_t>(first / m_options.speed)) : std::chrono::microseconds(0));
+                scheduleLaunch();
+
+                std::vector<std::thread> threads;
+                for (uint32_t i = 0; i < std::max<uint32_t>(m_options.threads, 1); ++i) {
+                    threads.emplace_back([this]() { m_ioContext.run(); });
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+                m_elapsed = std::chrono::duration<double>(Clock::now() - m_start).count();
+            }
+
+            Stats& getStats() {
+                return m_stats;
+            }
+
+            void printReport() const {
+                std::printf("\n%zu sessions replayed in %.2f s (recorded %.2f s)\n", m_recording.sessions.size(), m_elapsed, m_recording.duration / 1e6);
+                std::printf("logged in %llu, rejected %llu, connect failed %llu, network errors %llu, protocol errors %llu, timeouts %llu\n",
+                    ull(m_stats.loggedIn), ull(m_stats.rejected), ull(m_stats.connectFailed), ull(m_stats.networkErrors),
+                    ull(m_stats.protocolErrors), ull(m_stats.timeouts));
+                std::printf("packets sent %llu, received %llu, central answers %llu\n", ull(m_stats.packetsSent), ull(m_stats.packetsReceived), ull(m_stats.centralAnswers));
+
+                std::printf("\nopcodes sent\n");
+                for (size_t opcode = 0; opcode < m_stats.opcodes.size(); ++opcode) {
+                    if (const uint64_t count = m_stats.opcodes[opcode].load()) {
+                        std::printf("%6zu %10llu\n", opcode, static_cast<unsigned long long>(count));
+                    }
+                }
+
+                printLatency("login", m_stats.loginLatency);
+                printLatency("send lag", m_stats.sendLag);
+
+                std::printf("\nlogin latency histogram\n");
+                m_stats.loginLatency.print(stdout);
+            }
+
+        private:
+            static unsigned long long ull(const std::atomic<uint64_t>& value) {
+                return static_cast<unsigned long long>(value.load());
+            }
+
+            static void printLatency(const char* name, const LatencyHistogram& histogram) {
+                std::printf("\n%s (us): mean %llu, p50 %llu, p90 %llu, p99 %llu, p99.9 %llu, max %llu\n", name,
+                    static_cast<unsigned long long>(histogram.getMean()), static_cast<unsigned long long>(histogram.getPercentile(0.5)),
+                    static_cast<unsigned long long>(histogram.getPercentile(0.9)), static_cast<unsigned long long>(histogram.getPercentile(0.99)),
+                    static_cast<unsigned long long>(histogram.getPercentile(0.999)), static_cast<unsigned long long>(histogram.getMax()));
+            }
+
+            // sessions are started when their login is due, not all at once
+            void scheduleLaunch() {
+                while (m_nextSession < m_recording.sessions.size()) {
+                    const Recording::Session& recorded = m_recording.sessions[m_nextSession];
+                    const Clock::time_point due = m_options.speed > 0 ? m_origin + std::chrono::microseconds(static_cast<uint64_t>(recorded.loginTime / m_options.speed)) : Clock::now();
+                    if (due > Clock::now()) {
+                        m_launchTimer.expires_at(due);
+                        m_launchTimer.async_wait([this](const boost::system::error_code& error) {
+                            if (!error) {
+                                scheduleLaunch();
+                            }
+                        });
+                        return;
+                    }
+
+                    ++m_nextSession;
+                    m_stats.started.fetch_add(1, std::memory_order_relaxed);
+                    m_stats.active.fetch_add(1);
+                    auto session = std::make_shared<ReplaySession>(m_ioContext, m_options, m_publicKey, m_stats, recorded, m_origin);
+                    session->start(m_endpoint, [this]() { onSessionDone(); });
+                }
+                m_launched = true;
+                checkDone();
+            }
+
+            void onSessionDone() {
+                m_stats.active.fetch_sub(1);
+                checkDone();
+            }
+
+            // lets run() return once every session is launched and done
+            void checkDone() {
+                if (m_launched && m_stats.active.load() == 0) {
+                    std::call_once(m_stopped, [this]() { m_work.reset(); });
+                }
+            }
+
+            const Options& m_options;
+            Recording::Recording m_recording;
+            size_t m_nextSession = 0;
+            std::atomic<bool> m_launched{false};
+
+            boost::asio::io_context m_ioContext;
+            boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+            std::once_flag m_stopped;
+            boost::asio::steady_timer m_launchTimer;
+            boost::asio::ip::tcp::endpoint m_endpoint;
+            LoginClient::PublicKey m_publicKey;
+
+            Stats m_stats;
+            Clock::time_point m_start;
+            Clock::time_point m_origin;
+            double m_elapsed = 0;
+    };
+
+    /**
+     * Stand-in for the central: answers the central_login requests of the
+     * server (RedisRequests, "__answerId") on the login channel with the
+     * --game-server address.
+     */
+    class CentralStandIn
+    {
+        public:
+            CentralStandIn(const Options& options, Stats& stats) : m_options(options), m_stats(stats) {}
+
+            ~CentralStandIn() {
+                stop();
+                if (m_subscriber) {
+                    redisFree(m_subscriber);
+                }
+                if (m_publisher) {
+                    redisFree(m_publisher);
+                }
+            }
+
+            // non-copyable
+            CentralStandIn(const CentralStandIn&) = delete;
+            CentralStandIn& operator=(const CentralStandIn&) = delete;
+
+            bool start() {
+                std::string host;
+                uint16_t port;
+                if (!splitAddress(m_options.central, host, port) || !splitAddress(m_options.gameServer, m_gameServerHost, m_gameServerPort)) {
+                    std::cerr << "--central and --game-server take host:port" << std::endl;
+                    return false;
+                }
+
+                m_subscriber = redisConnect(host.c_str(), port);
+                m_publisher = redisConnect(host.c_str(), port);
+                if (!m_subscriber || m_subscriber->err || !m_publisher || m_publisher->err) {
+                    std::cerr << "Failed to connect to redis " << m_options.central << std::endl;
+                    return false;
+                }
+
+                // wakes the subscriber up to check m_running
+                const timeval timeout{0, 200000};
+                redisSetTimeout(m_subscriber, timeout);
+
+                freeReplyObject(redisCommand(m_subscriber, "SUBSCRIBE central_login"));
+                m_running = true;
+                m_thread = std::thread([this]() { threadMain(); });
+                return true;
+            }
+
+            void stop() {
+                m_running = false;
+                if (m_thread.joinable()) {
+                    m_thread.join();
+                }
+            }
+
+        private:
+            void threadMain() {
+                while (m_running) {
+                    redisReply* reply = nullptr;
+                    if (redisGetReply(m_subscriber, reinterpret_cast<void**>(&reply)) != REDIS_OK) {
+                        // read timeout, the context has to be usable again
+                        m_subscriber->err = 0;
+                        continue;
+                    }
+
+                    if (reply->type == REDIS_REPLY_ARRAY && reply->elements == 3 && reply->element[2]->type == REDIS_REPLY_STRING) {
+                        answer(std::string(reply->element[2]->str, reply->element[2]->len));
+                    }
+                    freeReplyObject(reply);
+                }
+            }
+
+            void answer(const std::string& request) {
+                static const std::string field = "\"__answerId\":";
+                const size_t position = request.find(field);
+                if (position == std::string::npos) {
+                    return;
+                }
+
+                const unsigned long long answerId = std::strtoull(request.c_str() + position + field.size(), nullptr, 10);
+                const std::string message = "{\"__answer\":true,\"__answerId\":" + std::to_string(answerId) + ",\"success\":true,\"host\":\"" +
+                    m_gameServerHost + "\",\"port\":" + std::to_string(m_gameServerPort) + "}";
+                freeReplyObject(redisCommand(m_publisher, "PUBLISH login %b", message.data(), message.size()));
+                m_stats.centralAnswers.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const Options& m_options;
+            Stats& m_stats;
+
+            redisContext* m_subscriber = nullptr;
+            redisContext* m_publisher = nullptr;
+            std::string m_gameServerHost;
+            uint16_t m_gameServerPort = 0;
+
+            std::atomic<bool> m_running{false};
+            std::thread m_thread;
+    };
+
+    // accountStore = "memory" file (include/database/memoryaccountstore.h)
+    bool writeAccounts(const Options& options, const Recording::Recording& recording)
+    {
+        std::set<std::string> emails;
+        for (const Recording::Session& session : recording.sessions) {
+            emails.insert(session.email);
+        }
+        if (emails.size() > UINT16_MAX) {
+            std::cerr << emails.size() << " accounts do not fit the 16 bit account ids" << std::endl;
+            return false;
+        }
+
+        std::ofstream file(options.accountsFile);
+        file << "# written by tools/replay from " << options.recordingFile << "\n";
+        uint32_t id = 0;
+        for (const std::string& email : emails) {
+            file << "account\t" << ++id << "\t" << email << "\tplain:" << options.password << "\t0\n";
+        }
+
+        if (!file) {
+            std::cerr << "Failed to write " << options.accountsFile << std::endl;
+            return false;
+        }
+        std::printf("%zu accounts written to %s\n", emails.size(), options.accountsFile.c_str());
+        return true;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const std::string name = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << name << std::endl;
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (name == "--recording") {
+                options.recordingFile = value;
+            } else if (name == "--host") {
+                options.host = value;
+            } else if (name == "--port") {
+                options.port = static_cast<uint16_t>(std::stoul(value));
+            } else if (name == "--speed") {
+                options.speed = std::stod(value);
+            } else if (name == "--threads") {
+                options.threads = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--timeout") {
+                options.timeout = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--linger") {
+                options.linger = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "--key") {
+                options.keyFile = value;
+            } else if (name == "--password") {
+                options.password = value;
+            } else if (name == "--write-accounts") {
+                options.accountsFile = value;
+            } else if (name == "--central") {
+                options.central = value;
+            } else if (name == "--game-server") {
+                options.gameServer = value;
+            } else {
+                std::cerr << "Unknown option " << name << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid option value: " << e.what() << std::endl;
+        return 1;
+    }
+
+    Recording::Recording recording;
+    try {
+        recording = Recording::load(options.recordingFile);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load the recording: " << e.what() << std::endl;
+        return 1;
+    }
+    std::printf("%zu sessions, %llu records over %.2f s (%llu records of connections opened before the recording skipped)\n", recording.sessions.size(),
+        static_cast<unsigned long long>(recording.records), recording.duration / 1e6, static_cast<unsigned long long>(recording.skippedRecords));
+
+    if (!options.accountsFile.empty()) {
+        return writeAccounts(options, recording) ? 0 : 1;
+    }
+
+    Replayer replayer(options, std::move(recording));
+    if (!replayer.init()) {
+        return 1;
+    }
+
+    std::unique_ptr<CentralStandIn> central;
+    if (!options.central.empty()) {
+        central = std::make_unique<CentralStandIn>(options, replayer.getStats());
+        if (!central->start()) {
+            return 1;
+        }
+    }
+
+    std::printf("replaying against %s:%u at %s\n", options.host.c_str(), options.port,
+        options.speed > 0 ? (std::to_string(options.speed) + "x").c_str() : "full speed");
+    replayer.run();
+    if (central) {
+        central->stop();
+    }
+    replayer.printReport();
+    return 0;
+}